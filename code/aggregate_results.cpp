@@ -0,0 +1,371 @@
+// aggregate_results.cpp
+// Versión nativa de extract.py: lee los directorios results_<alg> (los
+// results_F_D.txt de cec17 y los results_F_D.bin de --binary) y escribe en
+// cada uno, por dimensión, results_cec2017_D.csv con el error medio de cada
+// función en cada milestone y results_cec2017_D_std.csv con su desviación
+// típica. Las columnas son las de la hoja que escribe extract.py (índice,
+// milestone, F01..F30, dimension), así que se abre igual en una hoja de
+// cálculo o se convierte a .xlsx sin cambios.
+//
+// Cada fichero se lee una vez, en paralelo con los demás, y sus errores se
+// acumulan al vuelo (Welford) por (dimensión, función, milestone). Lo de cada
+// fichero se guarda en aggregate_cache.bin del directorio junto con su tamaño
+// y fecha, así que al repetir solo se leen los ficheros nuevos o cambiados.
+//
+// Uso: aggregate_results [--threads N] [--no-cache] [directorio...]
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+#include "checkpoint.h"
+#include "run_record.h"
+#include "thread_pool.h"
+#include "welford.h"
+
+namespace fs = std::filesystem;
+
+static const int NUM_FUNCS = 30;
+static const int LAST_MILESTONE = 100;   // el milestone que cierra una ejecución
+
+static const std::uint32_t CACHE_MAGIC = 0x41474646;   // "FFGA"
+static const std::uint32_t CACHE_VERSION = 1;
+static const char* CACHE_FILE = "aggregate_cache.bin";
+
+struct CellKey {
+    int dim, func_id, milestone;
+
+    bool operator<(const CellKey& o) const {
+        if (dim != o.dim) return dim < o.dim;
+        if (milestone != o.milestone) return milestone < o.milestone;
+        return func_id < o.func_id;
+    }
+};
+
+struct Cell {
+    CellKey key;
+    Welford stats;
+};
+
+// Lo que aporta un fichero, identificado por tamaño y fecha
+struct FileSummary {
+    std::string name;
+    long long size = 0;
+    long long mtime = 0;
+    std::vector<Cell> cells;
+    long long runs = 0;
+    std::string problem;   // vacío si el fichero está completo
+};
+
+// Acumula por celdas las ejecuciones completas de un fichero; los
+// milestones de una ejecución solo cuentan cuando llega el último. Las
+// líneas se agrupan por su ejecución (columna run, 0 si no la hay), así
+// que las de varias ejecuciones pueden venir mezcladas.
+class RunAccumulator {
+public:
+    explicit RunAccumulator(FileSummary& summary) : summary_(summary) {}
+
+    void add(int dim, int func_id, int milestone, double error, long run = 0) {
+        std::vector<Cell>& pending = pending_[run];
+        pending.push_back(Cell{CellKey{dim, func_id, milestone}, {}});
+        pending.back().stats.add(error);
+        if (milestone >= LAST_MILESTONE) {
+            for (const Cell& c : pending) cells_[c.key].merge(c.stats);
+            pending.clear();
+            ++summary_.runs;
+        }
+    }
+
+    void finish() {
+        std::size_t left = 0;
+        for (const auto& [run, pending] : pending_) left += pending.size();
+        if (left > 0 && summary_.problem.empty())
+            summary_.problem = "incomplete run (" + std::to_string(left) + " milestones) ignored";
+        for (const auto& [key, stats] : cells_) summary_.cells.push_back(Cell{key, stats});
+    }
+
+private:
+    FileSummary& summary_;
+    std::map<long, std::vector<Cell>> pending_;
+    std::map<CellKey, Welford> cells_;
+};
+
+static bool read_file(const fs::path& path, std::string& text) {
+    FILE* in = std::fopen(path.string().c_str(), "rb");
+    if (in == nullptr) return false;
+    std::fseek(in, 0, SEEK_END);
+    long size = std::ftell(in);
+    std::fseek(in, 0, SEEK_SET);
+    text.resize(size > 0 ? (std::size_t)size : 0);
+    bool ok = text.empty() || std::fread(&text[0], 1, text.size(), in) == text.size();
+    std::fclose(in);
+    return ok;
+}
+
+// results_F_D.txt: cabecera "funcid,dim,milestone,error" y una línea por
+// milestone, con una o varias ejecuciones seguidas; con --raw, además la
+// columna run
+static void scan_csv(const fs::path& path, FileSummary& summary) {
+    std::string text;
+    if (!read_file(path, text)) {
+        summary.problem = "cannot be read";
+        return;
+    }
+    RunAccumulator acc(summary);
+    const char* p = text.c_str();
+    const char* end = p + text.size();
+    bool header = true;
+    int line = 0;
+    while (p < end) {
+        const char* eol = std::find(p, end, '\n');
+        ++line;
+        if (eol == p || (eol == p + 1 && *p == '\r')) {
+            p = eol + 1;
+            continue;
+        }
+        if (header) {
+            header = false;
+            if (std::string(p, eol).rfind("funcid,dim,milestone,error", 0) != 0) {
+                summary.problem = "unexpected header";
+                return;
+            }
+            p = eol + 1;
+            continue;
+        }
+        char* q;
+        long func_id = std::strtol(p, &q, 10);
+        bool ok = *q == ',';
+        long dim = ok ? std::strtol(q + 1, &q, 10) : 0;
+        ok = ok && *q == ',';
+        long milestone = ok ? std::strtol(q + 1, &q, 10) : 0;
+        ok = ok && *q == ',';
+        double error = ok ? std::strtod(q + 1, &q) : 0.0;
+        long run = ok && q < eol && *q == ',' ? std::strtol(q + 1, &q, 10) : 0;
+        ok = ok && q <= eol && (q == eol || *q == '\r');
+        if (!ok || func_id < 1 || func_id > NUM_FUNCS) {
+            summary.problem = "bad line " + std::to_string(line);
+            break;
+        }
+        acc.add((int)dim, (int)func_id, (int)milestone, error, run);
+        p = eol + 1;
+    }
+    acc.finish();
+}
+
+static void scan_binary(const fs::path& path, FileSummary& summary) {
+    std::vector<RunRecord> records;
+    if (!read_run_records(path.string(), records)) summary.problem = "not valid or ends in an incomplete record";
+    RunAccumulator acc(summary);
+    for (const RunRecord& r : records) {
+        if (r.func_id < 1 || r.func_id > NUM_FUNCS) continue;
+        for (int k = 0; k < r.milestones && k < RunRecord::MILESTONES; ++k)
+            acc.add(r.dim, r.func_id, r.milestone[k], r.error[k]);
+    }
+    acc.finish();
+}
+
+static void save_cache(const fs::path& dir, const std::vector<FileSummary>& files) {
+    CheckpointWriter out;
+    out.put(CACHE_MAGIC);
+    out.put(CACHE_VERSION);
+    out.put((long long)files.size());
+    for (const FileSummary& f : files) {
+        out.put((long long)f.name.size());
+        out.put_array(f.name.data(), f.name.size());
+        out.put(f.size);
+        out.put(f.mtime);
+        out.put(f.runs);
+        out.put((long long)f.problem.size());
+        out.put_array(f.problem.data(), f.problem.size());
+        out.put((long long)f.cells.size());
+        out.put_array(f.cells.data(), f.cells.size());
+    }
+    if (!out.save((dir / CACHE_FILE).string()))
+        std::cerr << "Warning: cannot write the cache in '" << dir.string() << "'\n";
+}
+
+static std::unordered_map<std::string, FileSummary> load_cache(const fs::path& dir) {
+    std::unordered_map<std::string, FileSummary> cache;
+    CheckpointReader in;
+    if (!in.load((dir / CACHE_FILE).string())) return cache;
+    if (in.get<std::uint32_t>() != CACHE_MAGIC || in.get<std::uint32_t>() != CACHE_VERSION) return cache;
+    auto read_string = [&](std::string& s) {
+        auto n = in.get<long long>();
+        if (!in.ok() || n < 0 || n > (1 << 20)) return false;
+        s.resize((std::size_t)n);
+        in.get_array(&s[0], s.size());
+        return in.ok();
+    };
+    auto n = in.get<long long>();
+    for (long long i = 0; i < n && in.ok(); ++i) {
+        FileSummary f;
+        if (!read_string(f.name)) break;
+        f.size = in.get<long long>();
+        f.mtime = in.get<long long>();
+        f.runs = in.get<long long>();
+        if (!read_string(f.problem)) break;
+        auto cells = in.get<long long>();
+        if (!in.ok() || cells < 0 || cells > (1 << 24)) break;
+        f.cells.resize((std::size_t)cells);
+        in.get_array(f.cells.data(), f.cells.size());
+        if (in.ok()) cache[f.name] = std::move(f);
+    }
+    if (!in.ok()) cache.clear();
+    return cache;
+}
+
+// Escribe una tabla (media o desviación) con las columnas de extract.py
+template <class F>
+static bool write_table(const fs::path& path, int dim, const std::map<int, std::vector<Welford>>& milestones,
+                        F&& value) {
+    FILE* out = std::fopen(path.string().c_str(), "w");
+    if (out == nullptr) {
+        std::cerr << "Error: no se puede escribir " << path.string() << "\n";
+        return false;
+    }
+    std::fprintf(out, ",milestone");
+    for (int f = 1; f <= NUM_FUNCS; ++f) std::fprintf(out, ",F%02d", f);
+    std::fprintf(out, ",dimension\n");
+    for (const auto& [milestone, funcs] : milestones) {
+        std::fprintf(out, "0,%d", milestone);
+        for (const Welford& w : funcs) std::fprintf(out, ",%.17g", value(w));
+        std::fprintf(out, ",%d\n", dim);
+    }
+    std::fclose(out);
+    return true;
+}
+
+// Agrega un directorio; false si faltan datos
+static bool aggregate(const fs::path& dir, ThreadPool& pool, bool use_cache) {
+    std::cout << "Working in '" << dir.string() << "'\n";
+
+    std::vector<FileSummary> files;
+    for (const auto& entry : fs::directory_iterator(dir)) {
+        const fs::path& file = entry.path();
+        std::string name = file.filename().string();
+        if (!entry.is_regular_file() || name.rfind("results_", 0) != 0 ||
+            (file.extension() != ".txt" && file.extension() != ".bin"))
+            continue;
+        std::error_code ec;
+        FileSummary f;
+        f.name = name;
+        f.size = (long long)entry.file_size(ec);
+        f.mtime = (long long)entry.last_write_time(ec).time_since_epoch().count();
+        files.push_back(std::move(f));
+    }
+    std::sort(files.begin(), files.end(),
+              [](const FileSummary& a, const FileSummary& b) { return a.name < b.name; });
+    // Con --binary cada ejecución está en el .txt y en el .bin: vale el .bin,
+    // que guarda los errores sin redondear
+    std::set<std::string> binaries;
+    for (const FileSummary& f : files)
+        if (fs::path(f.name).extension() == ".bin") binaries.insert(fs::path(f.name).stem().string());
+    files.erase(std::remove_if(files.begin(), files.end(), [&](const FileSummary& f) {
+                    return fs::path(f.name).extension() == ".txt" && binaries.count(fs::path(f.name).stem().string());
+                }), files.end());
+
+    // Los que no han cambiado desde la última vez salen de la caché
+    std::vector<int> pending;
+    auto cache = use_cache ? load_cache(dir) : std::unordered_map<std::string, FileSummary>{};
+    for (int i = 0; i < (int)files.size(); ++i) {
+        auto it = cache.find(files[i].name);
+        if (it != cache.end() && it->second.size == files[i].size && it->second.mtime == files[i].mtime)
+            files[i] = std::move(it->second);
+        else
+            pending.push_back(i);
+    }
+    pool.parallel_for((int)pending.size(), [&](int k) {
+        FileSummary& f = files[pending[k]];
+        fs::path path = dir / f.name;
+        if (path.extension() == ".bin") scan_binary(path, f);
+        else scan_csv(path, f);
+    });
+    if (use_cache) save_cache(dir, files);
+
+    // dimensión -> milestone -> función
+    std::map<int, std::map<int, std::vector<Welford>>> dims;
+    long long runs = 0;
+    for (const FileSummary& f : files) {
+        if (!f.problem.empty()) std::cerr << "Warning: '" << f.name << "': " << f.problem << "\n";
+        runs += f.runs;
+        for (const Cell& c : f.cells) {
+            auto& funcs = dims[c.key.dim][c.key.milestone];
+            if (funcs.empty()) funcs.resize(NUM_FUNCS);
+            funcs[c.key.func_id - 1].merge(c.stats);
+        }
+    }
+    std::cout << files.size() << " files (" << pending.size() << " read), " << runs << " runs\n";
+    if (dims.empty()) {
+        std::cerr << "Error, there are no results in '" << dir.string() << "'\n";
+        return false;
+    }
+
+    // Todas las funciones deben tener los mismos milestones; si no, la tabla
+    // mezclaría medias de distinto número de ejecuciones
+    bool complete = true;
+    for (const auto& [dim, milestones] : dims) {
+        std::set<int> missing;
+        std::set<long long> counts;
+        for (const auto& [milestone, funcs] : milestones)
+            for (int f = 0; f < NUM_FUNCS; ++f) {
+                if (funcs[f].n == 0) missing.insert(f + 1);
+                else counts.insert(funcs[f].n);
+            }
+        if (!missing.empty()) {
+            std::cerr << "Missing data of functions in dimension " << dim << ":";
+            for (int f : missing) std::cerr << " " << f;
+            std::cerr << "\n";
+            complete = false;
+            continue;
+        }
+        if (counts.size() > 1)
+            std::cerr << "Warning: dimension " << dim << " has a different number of runs per function\n";
+
+        std::string name = "results_cec2017_" + std::to_string(dim);
+        complete = write_table(dir / (name + ".csv"), dim, milestones,
+                               [](const Welford& w) { return w.mean; }) &&
+                   write_table(dir / (name + "_std.csv"), dim, milestones,
+                               [](const Welford& w) { return w.sd(); }) && complete;
+        std::cout << name << ".csv (" << milestones.size() << " milestones)\n";
+    }
+    return complete;
+}
+
+int main(int argc, char* argv[]) {
+    int num_threads = 0;
+    bool use_cache = true;
+    std::vector<fs::path> dirs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            num_threads = std::atoi(argv[++i]);
+        } else if (arg == "--no-cache") {
+            use_cache = false;
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "Uso: " << argv[0] << " [--threads N] [--no-cache] [directorio...]\n";
+            return EXIT_FAILURE;
+        } else {
+            dirs.push_back(arg);
+        }
+    }
+    if (dirs.empty()) dirs.push_back(".");
+
+    ThreadPool pool(num_threads);
+    bool ok = true;
+    for (const fs::path& dir : dirs) {
+        if (!fs::is_directory(dir)) {
+            std::cerr << "Error, directory '" << dir.string() << "' does not exist\n";
+            ok = false;
+            continue;
+        }
+        ok = aggregate(dir, pool, use_cache) && ok;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,89 @@
+// alloc_counter.cpp
+#include "alloc_counter.h"
+
+#ifdef FIREFLY_ALLOC_COUNT
+
+#include <cstdlib>
+#include <new>
+
+// Por hilo: con varias ejecuciones a la vez cada una ve solo las suyas
+static thread_local long long allocations = 0;
+
+long long alloc_count() {
+    return allocations;
+}
+
+// Se sustituye la familia entera (simple y de arrays, con tamaño, nothrow y
+// alineada) sobre las mismas funciones, para que ningún delete de la
+// biblioteca libere lo reservado aquí ni al revés
+static void* allocate(std::size_t size) noexcept {
+    ++allocations;
+    return std::malloc(size ? size : 1);
+}
+
+static void* allocate(std::size_t size, std::align_val_t align) noexcept {
+    ++allocations;
+    std::size_t a = static_cast<std::size_t>(align);
+    size = (size ? size + a - 1 : a) / a * a;   // aligned_alloc: múltiplo de a
+#ifdef _MSC_VER
+    return _aligned_malloc(size, a);
+#else
+    return std::aligned_alloc(a, size);
+#endif
+}
+
+static void release(void* p) noexcept { std::free(p); }
+
+static void release(void* p, std::align_val_t) noexcept {
+#ifdef _MSC_VER
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = allocate(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = allocate(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    if (void* p = allocate(size, align)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t align) {
+    if (void* p = allocate(size, align)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return allocate(size, align);
+}
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return allocate(size, align);
+}
+
+void operator delete(void* p) noexcept { release(p); }
+void operator delete[](void* p) noexcept { release(p); }
+void operator delete(void* p, std::size_t) noexcept { release(p); }
+void operator delete[](void* p, std::size_t) noexcept { release(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { release(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { release(p); }
+
+void operator delete(void* p, std::align_val_t align) noexcept { release(p, align); }
+void operator delete[](void* p, std::align_val_t align) noexcept { release(p, align); }
+void operator delete(void* p, std::size_t, std::align_val_t align) noexcept { release(p, align); }
+void operator delete[](void* p, std::size_t, std::align_val_t align) noexcept { release(p, align); }
+void operator delete(void* p, std::align_val_t align, const std::nothrow_t&) noexcept { release(p, align); }
+void operator delete[](void* p, std::align_val_t align, const std::nothrow_t&) noexcept { release(p, align); }
+
+#else
+
+long long alloc_count() { return -1; }
+
+#endif
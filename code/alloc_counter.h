@@ -0,0 +1,11 @@
+// alloc_counter.h
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+// Contador de reservas de memoria dinámica (operator new) del hilo actual,
+// para comprobar que los bucles calientes no reservan memoria. Solo existe si
+// se compila con FIREFLY_ALLOC_COUNT (cmake -DFIREFLY_ALLOC_COUNT=ON); si no,
+// alloc_count() devuelve -1.
+long long alloc_count();
+
+#endif // ALLOC_COUNTER_H
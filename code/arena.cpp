@@ -0,0 +1,48 @@
+// arena.cpp
+#include "arena.h"
+#include <cstdint>
+#include <cstdlib>
+
+Arena::Arena(std::size_t block_size) : block_size_(block_size) {}
+
+Arena::~Arena() {
+    for (auto& b : blocks_) std::free(b.data);
+}
+
+void* Arena::allocate(std::size_t bytes, std::size_t align) {
+    for (;;) {
+        if (current_ < blocks_.size()) {
+            Block& b = blocks_[current_];
+            std::uintptr_t base = reinterpret_cast<std::uintptr_t>(b.data);
+            std::size_t start = ((base + offset_ + align - 1) & ~(std::uintptr_t)(align - 1)) - base;
+            if (start + bytes <= b.size) {
+                used_ += start + bytes - offset_;
+                offset_ = start + bytes;
+                return b.data + start;
+            }
+            // No cabe: lo que queda del bloque se pierde hasta el reset
+            used_ += b.size - offset_;
+            ++current_;
+            offset_ = 0;
+            continue;
+        }
+        std::size_t size = bytes + align > block_size_ ? bytes + align : block_size_;
+        char* data = static_cast<char*>(std::malloc(size));
+        if (!data) throw std::bad_alloc();
+        blocks_.push_back({data, size});
+        current_ = blocks_.size() - 1;
+        offset_ = 0;
+    }
+}
+
+void Arena::reset() {
+    current_ = 0;
+    offset_ = 0;
+    used_ = 0;
+}
+
+std::size_t Arena::capacity() const {
+    std::size_t total = 0;
+    for (const auto& b : blocks_) total += b.size;
+    return total;
+}
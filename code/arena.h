@@ -0,0 +1,71 @@
+// arena.h
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Arena monótona para el estado de una ejecución.
+// Reserva por bloques y nunca libera piezas sueltas: reset() rebobina en
+// O(1) y conserva los bloques para la siguiente ejecución.
+class Arena {
+public:
+    explicit Arena(std::size_t block_size = 1 << 20);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(std::size_t bytes, std::size_t align);
+    void reset();
+
+    // Bytes ocupados desde el último reset(). Como la arena no libera,
+    // es también el pico de uso de la ejecución.
+    std::size_t used() const { return used_; }
+    std::size_t capacity() const;
+
+private:
+    struct Block { char* data; std::size_t size; };
+
+    std::size_t block_size_;
+    std::vector<Block> blocks_;
+    std::size_t current_ = 0;   // bloque en uso
+    std::size_t offset_ = 0;    // primer byte libre del bloque en uso
+    std::size_t used_ = 0;
+};
+
+// Asignador para contenedores estándar respaldados por una Arena.
+// Sin arena se comporta como std::allocator; con o sin ella, vector<T>(n)
+// inicializa los elementos a cero como siempre.
+template <class T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    Arena* arena = nullptr;
+
+    ArenaAllocator() noexcept = default;
+    explicit ArenaAllocator(Arena* a) noexcept : arena(a) {}
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+    T* allocate(std::size_t n) {
+        if (arena) return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        if (!arena) std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena == other.arena; }
+    template <class U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena != other.arena; }
+};
+
+template <class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif // ARENA_H
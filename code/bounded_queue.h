@@ -0,0 +1,60 @@
+// bounded_queue.h
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+// Cola acotada con bloqueo para varios productores y consumidores.
+// Guarda hasta capacity elementos en un anillo reservado al crearla, así
+// que push/pop no reservan memoria.
+template <class T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(int capacity) : buf_(capacity > 0 ? capacity : 1) {}
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    int capacity() const { return static_cast<int>(buf_.size()); }
+
+    // Espera hueco si está llena
+    void push(const T& value) {
+        std::unique_lock<std::mutex> lock(mtx_);
+        not_full_.wait(lock, [this] { return size_ < capacity(); });
+        put(value);
+        not_empty_.notify_one();
+    }
+
+    // Espera un elemento si está vacía
+    T pop() {
+        std::unique_lock<std::mutex> lock(mtx_);
+        not_empty_.wait(lock, [this] { return size_ > 0; });
+        T value = buf_[head_];
+        head_ = (head_ + 1) % capacity();
+        --size_;
+        not_full_.notify_one();
+        return value;
+    }
+
+    int size() {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return size_;
+    }
+
+private:
+    void put(const T& value) {
+        buf_[(head_ + size_) % capacity()] = value;
+        ++size_;
+    }
+
+    std::vector<T> buf_;
+    int head_ = 0;
+    int size_ = 0;
+    std::mutex mtx_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+};
+
+#endif // BOUNDED_QUEUE_H
@@ -1,102 +1,400 @@
 #include <assert.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "cec17.h"
 
+#if defined(WIN32) || defined(_WIN32) || defined (_WIN64)
+#include <io.h>
+#define open _open
+#define write _write
+#define close _close
+#define lseek _lseek
+#else
+#include <unistd.h>
+#endif
+
 void cec17_test_func(double *x, double *f, int nx, int mx,int func_num);
 
-static int dimension;
-static int funcid;
-static int count;
+#if defined(_MSC_VER)
+#define CEC17_TLS __declspec(thread)
+#else
+#define CEC17_TLS _Thread_local
+#endif
+
 static int ratios[] = {1, 2, 3, 5, 10, 20, 30, 40, 50, 60, 70, 80, 90, 100};
-static int max_evals;
 static int max_ratios = 14;
-static int last_ratio = 0;
-static char fname[300];
-static double best;
-static char directory[30];
-static int print_output = 0;
 
-void cec17_init(const char *algname, int fid, int size) {
+/*
+ * Fichero de milestones: se abre una vez por ejecución y las líneas se
+ * acumulan en memoria hasta el final de la ejecución (último milestone,
+ * cec17_finish, cec17_flush o el siguiente cec17_init). Lo pendiente se
+ * escribe también al salir (atexit) y, fuera de Windows, al recibir
+ * SIGINT, SIGTERM o SIGHUP.
+ * Cada ejecución con el fichero abierto usa un hueco de una tabla global
+ * para que el manejador de señales pueda recorrerlos; con la tabla llena
+ * se escribe al momento.
+ */
+#define LOGGER_SLOTS 256
+#define LOGGER_BUFFER 2048
+
+typedef struct {
+  atomic_int used;
+  atomic_int busy;          /* el dueño está escribiendo */
+  atomic_int len;           /* bytes pendientes en buf */
+  int fd;                   /* -1 sin fichero abierto */
+  char buf[LOGGER_BUFFER];
+} milestone_logger;
+
+/* Estado de una ejecución (contador, mejor, milestones, salida) */
+struct cec17_context {
+  int dimension;
+  int funcid;
+  int count;
+  int max_evals;
+  int last_ratio;
+  char fname[300];
+  double best;
+  char directory[300];
+  int print_output;   /* 0: fichero, 1: pantalla, 2: nada */
+  int run;            /* > 0: columna run en el fichero */
+  cec17_milestone_fn milestone_fn;
+  void *milestone_ctx;
+  milestone_logger *log;
+};
+
+/* Contexto de la API sin _r: uno por hilo */
+static CEC17_TLS cec17_context default_context;
+
+static milestone_logger loggers[LOGGER_SLOTS];
+static atomic_int handlers_installed = 0;
+
+/* Escribe lo pendiente; solo write(), así vale en un manejador de señal */
+static void logger_write(milestone_logger *log) {
+  int len = atomic_load(&log->len);
+  int done = 0;
+  while (done < len) {
+    int n = (int)write(log->fd, log->buf + done, len - done);
+    if (n <= 0) break;
+    done += n;
+  }
+}
+
+static void flush_all(void) {
+  for (int i = 0; i < LOGGER_SLOTS; i++) {
+    milestone_logger *log = &loggers[i];
+    if (atomic_load(&log->used) && !atomic_load(&log->busy) && log->fd >= 0) {
+      logger_write(log);
+      atomic_store(&log->len, 0);
+    }
+  }
+}
+
+#if !(defined(WIN32) || defined(_WIN32) || defined (_WIN64))
+static struct sigaction previous[3];
+static const int flushed_signals[3] = {SIGINT, SIGTERM, SIGHUP};
+
+static void flush_on_signal(int sig) {
+  flush_all();
+  for (int i = 0; i < 3; i++) {
+    if (flushed_signals[i] == sig) {
+      sigaction(sig, &previous[i], NULL);
+    }
+  }
+  raise(sig);
+}
+#endif
+
+static void install_handlers(void) {
+  int expected = 0;
+  if (!atomic_compare_exchange_strong(&handlers_installed, &expected, 1)) {
+    return;
+  }
+  atexit(flush_all);
+#if !(defined(WIN32) || defined(_WIN32) || defined (_WIN64))
+  for (int i = 0; i < 3; i++) {
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = flush_on_signal;
+    sigemptyset(&sa.sa_mask);
+    sigaction(flushed_signals[i], &sa, &previous[i]);
+  }
+#endif
+}
+
+/* Reserva un hueco con el fichero ya abierto; NULL si la tabla está llena */
+static milestone_logger *logger_claim(int fd) {
+  install_handlers();
+  for (int i = 0; i < LOGGER_SLOTS; i++) {
+    int expected = 0;
+    if (atomic_compare_exchange_strong(&loggers[i].used, &expected, 1)) {
+      atomic_store(&loggers[i].len, 0);
+      loggers[i].fd = fd;
+      return &loggers[i];
+    }
+  }
+  return NULL;
+}
+
+/* Fin de la ejecución: escribe lo pendiente, cierra y libera el hueco */
+static void logger_close(cec17_context *ctx) {
+  milestone_logger *log = ctx->log;
+  if (log == NULL) {
+    return;
+  }
+  atomic_store(&log->busy, 1);
+  logger_write(log);
+  atomic_store(&log->len, 0);
+  close(log->fd);
+  log->fd = -1;
+  atomic_store(&log->busy, 0);
+  atomic_store(&log->used, 0);
+  ctx->log = NULL;
+}
+
+static void logger_append(cec17_context *ctx, const char *line) {
+  milestone_logger *log = ctx->log;
+  int size = (int)strlen(line);
+
+  if (log == NULL) {
+    int fd = open(ctx->fname, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+      fprintf(stderr, "Error, it cannot be possible to create file '%s', the directory '%s' exists?\n", ctx->fname, ctx->directory);
+      exit(1);
+    }
+    int empty = lseek(fd, 0, SEEK_END) == 0;
+    const char *header = ctx->run > 0 ? "funcid,dim,milestone,error,run\n" : "funcid,dim,milestone,error\n";
+    log = ctx->log = logger_claim(fd);
+    if (log == NULL) {
+      /* Sin hueco: se escribe directamente */
+      if (empty) {
+        (void)!write(fd, header, (unsigned)strlen(header));
+      }
+      (void)!write(fd, line, (unsigned)size);
+      close(fd);
+      return;
+    }
+    if (empty) {
+      logger_append(ctx, header);
+    }
+  }
+
+  if (atomic_load(&log->len) + size > LOGGER_BUFFER) {
+    atomic_store(&log->busy, 1);
+    logger_write(log);
+    atomic_store(&log->len, 0);
+    atomic_store(&log->busy, 0);
+  }
+  memcpy(log->buf + atomic_load(&log->len), line, size);
+  atomic_fetch_add(&log->len, size);
+}
+
+cec17_context *cec17_context_new(void) {
+  return calloc(1, sizeof(cec17_context));
+}
+
+void cec17_context_free(cec17_context *ctx) {
+  if (ctx != NULL) {
+    logger_close(ctx);
+    free(ctx);
+  }
+}
+
+void cec17_init_r(cec17_context *ctx, const char *algname, int fid, int size) {
   assert (fid > 0 && fid <= 30);
   assert (size == 2 || size == 5 || size == 10 || size == 30 || size == 50 || size == 100);
-  funcid = fid;
-  dimension = size;
-  count = 0;
-  last_ratio = 0;
+  logger_close(ctx);
+  ctx->funcid = fid;
+  ctx->dimension = size;
+  ctx->count = 0;
+  ctx->last_ratio = 0;
 
-  sprintf(directory, "results_%s", algname);
-  sprintf(fname, "%s%cresults_%d_%d.txt", directory, PATH_SEPARATOR, fid, size);
-  print_output = 0;
-  max_evals = 10000*dimension;
+  /* Un nombre cortado apuntaría a un directorio que no existe */
+  int len = snprintf(ctx->directory, sizeof(ctx->directory), "results_%s", algname);
+  if (len < 0 || len >= (int)sizeof(ctx->directory) ||
+      snprintf(ctx->fname, sizeof(ctx->fname), "%s%cresults_%d_%d.txt", ctx->directory, PATH_SEPARATOR, fid, size) >= (int)sizeof(ctx->fname)) {
+    fprintf(stderr, "Error, the algorithm name '%s' is too long for the results file name\n", algname);
+    exit(1);
+  }
+  ctx->print_output = 0;
+  ctx->run = 0;
+  ctx->milestone_fn = NULL;
+  ctx->milestone_ctx = NULL;
+  ctx->max_evals = 10000*size;
 }
 
-void cec17_print_output(void) {
-  print_output = 1;
+void cec17_print_output_r(cec17_context *ctx) {
+  ctx->print_output = 1;
 }
 
-double cec17_error(double fitness) {
-  const double optimum = funcid*100;
+void cec17_no_output_r(cec17_context *ctx) {
+  ctx->print_output = 2;
+}
+
+void cec17_set_run_r(cec17_context *ctx, int run) {
+  ctx->run = run;
+}
+
+void cec17_set_milestone_callback_r(cec17_context *ctx, cec17_milestone_fn fn, void *fn_ctx) {
+  ctx->milestone_fn = fn;
+  ctx->milestone_ctx = fn_ctx;
+}
+
+const char *cec17_output_file_r(const cec17_context *ctx) {
+  return ctx->fname;
+}
+
+void cec17_get_progress_r(const cec17_context *ctx, int *evals, double *best_fitness, int *milestones) {
+  *evals = ctx->count;
+  *best_fitness = ctx->best;
+  *milestones = ctx->last_ratio;
+}
+
+void cec17_set_progress_r(cec17_context *ctx, int evals, double best_fitness, int milestones) {
+  assert (evals >= 0 && evals <= ctx->max_evals);
+  assert (milestones >= 0 && milestones < max_ratios);
+  ctx->count = evals;
+  ctx->best = best_fitness;
+  ctx->last_ratio = milestones;
+}
+
+double cec17_error_r(const cec17_context *ctx, double fitness) {
+  const double optimum = ctx->funcid*100;
   assert (fitness >= optimum);
   return fitness - optimum;
 }
 
-double cec17_fitness(double *sol) {
+double cec17_evaluate(double *sol, int fid, int size) {
   double fit;
-  static FILE *output  = NULL;
-  int ratio;
+  cec17_test_func(sol, &fit, size, 1, fid);
+  return fit;
+}
 
-  cec17_test_func(sol, &fit, dimension, 1, funcid);
-  count += 1;
+double cec17_fitness_r(cec17_context *ctx, double *sol) {
+  return cec17_register_r(ctx, cec17_evaluate(sol, ctx->funcid, ctx->dimension));
+}
 
-  if (count > max_evals) {
-      fprintf(stderr, "Warning: evaluation will be ignored\n");
-      return fit;
+/* Registra el milestone ratio con el mejor error hasta ahora */
+static void write_milestone(cec17_context *ctx, int ratio) {
+  char line[128];
+  double error = cec17_error_r(ctx, ctx->best);
+
+  if (ctx->milestone_fn != NULL) {
+    ctx->milestone_fn(ctx->milestone_ctx, ratio, error);
   }
 
-  if (count == 1 || fit < best) {
-    best = fit;
+  if (ctx->print_output == 1) {
+    printf("%d,%d,%d,%e\n", ctx->funcid, ctx->dimension, ratio, error);
+    fflush(stdout);
+  }
+  else if (ctx->print_output == 0) {
+    if (ctx->run > 0)
+      snprintf(line, sizeof(line), "%d,%d,%d,%e,%d\n", ctx->funcid, ctx->dimension, ratio, error, ctx->run);
+    else
+      snprintf(line, sizeof(line), "%d,%d,%d,%e\n", ctx->funcid, ctx->dimension, ratio, error);
+    logger_append(ctx, line);
   }
+}
 
-  ratio = count*100/max_evals;
+void cec17_flush_r(cec17_context *ctx) {
+  logger_close(ctx);
+}
 
-  if (ratio >= ratios[last_ratio]) {
-    if (output == NULL && print_output == 0) {
-      int exists = 0;
-      FILE *ver = fopen(fname, "r");
-      if (ver != NULL) {
-        exists = 1;
-        fclose(ver);
-      }
+double cec17_register_r(cec17_context *ctx, double fit) {
+  int ratio;
 
-      output = fopen(fname, "a");
+  ctx->count += 1;
 
-      if (output == NULL) {
-        fprintf(stderr, "Error, it cannot be possible to create file '%s', the directory '%s' exists?\n", fname, directory);
-        exit(1);
-      }
+  if (ctx->count > ctx->max_evals) {
+      fprintf(stderr, "Warning: evaluation will be ignored\n");
+      return fit;
+  }
 
-      if (!exists) {
-        fprintf(output, "funcid,dim,milestone,error\n");
-      }
-    }
+  if (ctx->count == 1 || fit < ctx->best) {
+    ctx->best = fit;
+  }
 
-    if (print_output == 1) {
-      printf("%d,%d,%d,%e\n", funcid, dimension, ratio, cec17_error(best));
-      fflush(stdout);
-    }
-    else {
-      fprintf(output, "%d,%d,%d,%e\n", funcid, dimension, ratio, cec17_error(best));
-      fclose(output);
-      output = NULL;
-    }
-    last_ratio += 1;
+  ratio = ctx->count*100/ctx->max_evals;
 
-    if (last_ratio >= max_ratios) {
-      last_ratio = 0;
+  if (ratio >= ratios[ctx->last_ratio]) {
+    write_milestone(ctx, ratio);
+    ctx->last_ratio += 1;
+
+    if (ctx->last_ratio >= max_ratios) {
+      ctx->last_ratio = 0;
+      logger_close(ctx);
     }
 
   }
 
   return fit;
 }
+
+void cec17_finish_r(cec17_context *ctx) {
+  if (ctx->count == 0 || ctx->count >= ctx->max_evals) {
+    return;
+  }
+  for (; ctx->last_ratio < max_ratios; ctx->last_ratio++) {
+    write_milestone(ctx, ratios[ctx->last_ratio]);
+  }
+  ctx->last_ratio = 0;
+  ctx->count = ctx->max_evals;
+  logger_close(ctx);
+}
+
+/* API sin contexto: usa el del hilo */
+
+void cec17_init(const char *algname, int fid, int size) {
+  cec17_init_r(&default_context, algname, fid, size);
+}
+
+void cec17_print_output(void) {
+  cec17_print_output_r(&default_context);
+}
+
+void cec17_no_output(void) {
+  cec17_no_output_r(&default_context);
+}
+
+void cec17_set_run(int run) {
+  cec17_set_run_r(&default_context, run);
+}
+
+void cec17_set_milestone_callback(cec17_milestone_fn fn, void *ctx) {
+  cec17_set_milestone_callback_r(&default_context, fn, ctx);
+}
+
+const char *cec17_output_file(void) {
+  return cec17_output_file_r(&default_context);
+}
+
+void cec17_get_progress(int *evals, double *best_fitness, int *milestones) {
+  cec17_get_progress_r(&default_context, evals, best_fitness, milestones);
+}
+
+void cec17_set_progress(int evals, double best_fitness, int milestones) {
+  cec17_set_progress_r(&default_context, evals, best_fitness, milestones);
+}
+
+double cec17_error(double fitness) {
+  return cec17_error_r(&default_context, fitness);
+}
+
+double cec17_fitness(double *sol) {
+  return cec17_fitness_r(&default_context, sol);
+}
+
+double cec17_register(double fit) {
+  return cec17_register_r(&default_context, fit);
+}
+
+void cec17_flush(void) {
+  cec17_flush_r(&default_context);
+}
+
+void cec17_finish(void) {
+  cec17_finish_r(&default_context);
+}
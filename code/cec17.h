@@ -14,6 +14,9 @@ extern "C" {
 
 /**
  * Inicia la función de evaluación y la dimensión.
+ * El estado (contador, milestones, fichero) es propio de cada hilo, así que
+ * cada hilo puede llevar su propia ejecución a la vez; para varias en el
+ * mismo hilo, véase cec17_init_r.
  * @param algname (results will be copy to results_algname directory).
  * @param funcid debe ser entre 1 y 30.
  * @param dimension debe ser 2, 5, 10, 30, o 50.
@@ -25,6 +28,52 @@ void cec17_init(const char *algname, int funcid, int dimension);
  */
 void cec17_print_output(void);
 
+/**
+ * Desactiva la salida a fichero y por pantalla; los milestones solo llegan
+ * a la función de cec17_set_milestone_callback.
+ */
+void cec17_no_output(void);
+
+/**
+ * Con run > 0 cada línea del fichero lleva además la ejecución a la que
+ * pertenece (cabecera "funcid,dim,milestone,error,run"), para distinguir
+ * las de varias ejecuciones que escriben en el mismo fichero. cec17_init
+ * la quita.
+ */
+void cec17_set_run(int run);
+
+/**
+ * Función a la que se avisa de cada milestone con su porcentaje y el error
+ * del mejor hasta ese momento.
+ */
+typedef void (*cec17_milestone_fn)(void *ctx, int milestone, double error);
+
+/**
+ * Registra fn (con su contexto) para los milestones de la ejecución del hilo,
+ * además de la salida habitual. NULL la quita; cec17_init también la quita.
+ */
+void cec17_set_milestone_callback(cec17_milestone_fn fn, void *ctx);
+
+/**
+ * Los milestones se guardan en memoria y se escriben juntos al terminar la
+ * ejecución (también al salir o con SIGINT/SIGTERM/SIGHUP). cec17_flush
+ * los escribe ya, por ejemplo antes de copiar o medir el fichero.
+ */
+void cec17_flush(void);
+
+/**
+ * Fichero de milestones de la ejecución del hilo (results_alg/results_F_D.txt).
+ */
+const char *cec17_output_file(void);
+
+/**
+ * Progreso de la ejecución del hilo: evaluaciones contabilizadas, mejor
+ * fitness y número de milestones ya registrados. Con cec17_set_progress,
+ * tras cec17_init, se reanuda una ejecución guardada en el mismo punto.
+ */
+void cec17_get_progress(int *evals, double *best_fitness, int *milestones);
+void cec17_set_progress(int evals, double best_fitness, int milestones);
+
 /**
  * Devuelve el error asociado al fitness.
  * @param fitness a comparar.
@@ -40,6 +89,77 @@ double cec17_error(double fitness);
  */
 double cec17_fitness(double *sol);
 
+/**
+ * Evalúa la solución sin contabilizarla ni registrar milestones.
+ * Es reentrante: cada hilo usa su propio contexto del evaluador, por lo
+ * que puede llamarse en paralelo. La evaluación debe contabilizarse
+ * después con cec17_register, en el orden deseado.
+ *
+ * @param sol solución a evaluar.
+ * @param funcid debe ser entre 1 y 30.
+ * @param dimension dimensión de la solución.
+ * @return fitness.
+ */
+double cec17_evaluate(double *sol, int funcid, int dimension);
+
+/**
+ * Libera los datos del evaluador del hilo actual (desplazamientos,
+ * rotaciones, permutaciones), que cec17_evaluate carga la primera vez en
+ * cada hilo. Hay que llamarla antes de que termine un hilo que ha evaluado;
+ * si después vuelve a evaluar, se cargan de nuevo.
+ */
+void cec17_thread_release(void);
+
+/**
+ * Contabiliza una evaluación ya calculada con cec17_evaluate, con el mismo
+ * efecto sobre el contador y los milestones que cec17_fitness.
+ *
+ * @param fitness resultado de la evaluación.
+ * @return fitness.
+ */
+double cec17_register(double fitness);
+
+/**
+ * Termina antes de agotar el presupuesto: registra los milestones que
+ * faltan con el error del mejor actual, como si la ejecución hubiera
+ * seguido sin mejorar, y el fichero de resultados queda completo.
+ * Las evaluaciones posteriores se ignoran.
+ */
+void cec17_finish(void);
+
+/*
+ * API reentrante. Cada ejecución lleva su estado (contador, mejor,
+ * milestones, fichero y salida) en un contexto, así que se pueden llevar
+ * varias ejecuciones a la vez, también en el mismo hilo. Las funciones
+ * anteriores equivalen a estas sobre un contexto propio de cada hilo.
+ */
+typedef struct cec17_context cec17_context;
+
+/**
+ * Crea un contexto; hay que iniciarlo con cec17_init_r.
+ * @return contexto, o NULL si no hay memoria.
+ */
+cec17_context *cec17_context_new(void);
+
+/**
+ * Escribe los milestones pendientes y libera el contexto.
+ */
+void cec17_context_free(cec17_context *ctx);
+
+void cec17_init_r(cec17_context *ctx, const char *algname, int funcid, int dimension);
+void cec17_print_output_r(cec17_context *ctx);
+void cec17_no_output_r(cec17_context *ctx);
+void cec17_set_run_r(cec17_context *ctx, int run);
+void cec17_set_milestone_callback_r(cec17_context *ctx, cec17_milestone_fn fn, void *fn_ctx);
+void cec17_flush_r(cec17_context *ctx);
+const char *cec17_output_file_r(const cec17_context *ctx);
+void cec17_get_progress_r(const cec17_context *ctx, int *evals, double *best_fitness, int *milestones);
+void cec17_set_progress_r(cec17_context *ctx, int evals, double best_fitness, int milestones);
+void cec17_finish_r(cec17_context *ctx);
+double cec17_error_r(const cec17_context *ctx, double fitness);
+double cec17_fitness_r(cec17_context *ctx, double *sol);
+double cec17_register_r(cec17_context *ctx, double fitness);
+
 #ifdef __cplusplus // Esto cierra el bloque extern "C"
 }
 #endif
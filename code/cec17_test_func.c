@@ -69,8 +69,30 @@ void asyfunc (double *, double *x, int, double);
 void oszfunc (double *, double *, int);
 void cf_cal(double *, double *, int, double *,double *,double *,double *,int);
 
-double *OShift,*M,*y,*z,*x_bound;
-int ini_flag,n_flag,func_flag,*SS;
+/* Contexto del evaluador: uno por hilo, para poder evaluar en paralelo */
+#if defined(_MSC_VER)
+#define CEC17_TLS __declspec(thread)
+#else
+#define CEC17_TLS _Thread_local
+#endif
+
+CEC17_TLS double *OShift,*M,*y,*z,*x_bound;
+CEC17_TLS int ini_flag,n_flag,func_flag,*SS;
+
+/* Libera los datos del evaluador del hilo; C no tiene destructores de
+   _Thread_local, así que cada hilo que evalúa debe llamarla al terminar */
+void cec17_thread_release(void)
+{
+	free(M);
+	free(OShift);
+	free(y);
+	free(z);
+	free(x_bound);
+	free(SS);
+	M=OShift=y=z=x_bound=NULL;
+	SS=NULL;
+	ini_flag=0;
+}
 
 
 void cec17_test_func(double *x, double *f, int nx, int mx,int func_num)
@@ -93,6 +115,8 @@ void cec17_test_func(double *x, double *f, int nx, int mx,int func_num)
 		free(y);
 		free(z);
 		free(x_bound);
+		free(SS);
+		SS=NULL;
 		y=(double *)malloc(sizeof(double)  *  nx);
 		z=(double *)malloc(sizeof(double)  *  nx);
 		x_bound=(double *)malloc(sizeof(double)  *  nx);
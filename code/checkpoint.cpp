@@ -0,0 +1,45 @@
+// checkpoint.cpp
+#include "checkpoint.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+static std::uint64_t fnv1a(const char* data, std::size_t size) {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+bool CheckpointWriter::save(const std::string& path) const {
+    std::string tmp = path + ".tmp";
+    {
+        std::uint64_t sum = fnv1a(buf_.data(), buf_.size());
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.write(buf_.data(), (std::streamsize)buf_.size())
+            || !out.write(reinterpret_cast<const char*>(&sum), sizeof(sum)) || !out.flush())
+            return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    return !ec;
+}
+
+bool CheckpointReader::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    buf_.clear();
+    pos_ = 0;
+    ok_ = false;
+    if (!in) return false;
+    buf_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    std::uint64_t sum;
+    if (in.bad() || buf_.size() < sizeof(sum)) return false;
+    std::memcpy(&sum, buf_.data() + buf_.size() - sizeof(sum), sizeof(sum));
+    buf_.resize(buf_.size() - sizeof(sum));
+    ok_ = sum == fnv1a(buf_.data(), buf_.size());
+    return ok_;
+}
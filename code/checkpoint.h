@@ -0,0 +1,84 @@
+// checkpoint.h
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Estado binario de una ejecución a medias, para reanudarla.
+// Los valores se escriben tal cual (mismo binario en la misma máquina), en
+// el mismo orden en que se leen después. El fichero termina con una suma de
+// comprobación (FNV-1a) del contenido, así que uno truncado o alterado no
+// se carga.
+class CheckpointWriter {
+public:
+    template <class T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "tipo no copiable byte a byte");
+        put_bytes(&value, sizeof(T));
+    }
+
+    template <class T>
+    void put_array(const T* values, std::size_t n) {
+        static_assert(std::is_trivially_copyable<T>::value, "tipo no copiable byte a byte");
+        put_bytes(values, n * sizeof(T));
+    }
+
+    void clear() { buf_.clear(); }
+
+    // Escribe en un temporal y lo renombra, así el checkpoint anterior sigue
+    // valiendo si la máquina cae a mitad de escritura
+    bool save(const std::string& path) const;
+
+private:
+    void put_bytes(const void* data, std::size_t size) {
+        const char* p = static_cast<const char*>(data);
+        buf_.insert(buf_.end(), p, p + size);
+    }
+
+    std::vector<char> buf_;
+};
+
+class CheckpointReader {
+public:
+    // false si no existe, no se puede leer o la suma de comprobación no
+    // coincide; entonces ok() también es false
+    bool load(const std::string& path);
+
+    // Tras leer de más, ok() pasa a false y todo lo leído vale 0
+    template <class T>
+    T get() {
+        T value{};
+        get_array(&value, 1);
+        return value;
+    }
+
+    template <class T>
+    void get_array(T* values, std::size_t n) {
+        static_assert(std::is_trivially_copyable<T>::value, "tipo no copiable byte a byte");
+        get_bytes(values, n * sizeof(T));
+    }
+
+    bool ok() const { return ok_; }
+    bool at_end() const { return pos_ == buf_.size(); }
+
+private:
+    void get_bytes(void* data, std::size_t size) {
+        if (!ok_ || buf_.size() - pos_ < size) {
+            ok_ = false;
+            std::memset(data, 0, size);
+            return;
+        }
+        std::memcpy(data, buf_.data() + pos_, size);
+        pos_ += size;
+    }
+
+    std::vector<char> buf_;
+    std::size_t pos_ = 0;
+    bool ok_ = false;
+};
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,74 @@
+// elite_archive.cpp
+#include "elite_archive.h"
+#include <algorithm>
+#include <utility>
+
+EliteArchive::EliteArchive(int capacity, int dim, Arena& arena)
+    : capacity_(capacity), dim_(dim),
+      pool_((size_t)capacity * dim, ArenaAllocator<double>(&arena)),
+      fit_(capacity, ArenaAllocator<double>(&arena)),
+      heap_(capacity, ArenaAllocator<int>(&arena)) {}
+
+// Dos posiciones iguales tienen el mismo fitness: solo se comparan las
+// coordenadas de los élites empatados
+bool EliteArchive::contains(const double* position, double fitness) const {
+    for (int s = 0; s < size_; ++s)
+        if (fit_[s] == fitness && std::equal(position, position + dim_, this->position(s)))
+            return true;
+    return false;
+}
+
+bool EliteArchive::offer(const double* position, double fitness) {
+    if (capacity_ <= 0) return false;
+    if (full() && !(fitness < worst_fitness())) return false;
+    if (contains(position, fitness)) return false;
+
+    if (!full()) {
+        int slot = size_;
+        std::copy(position, position + dim_, &pool_[(size_t)slot * dim_]);
+        fit_[slot] = fitness;
+        heap_[size_] = slot;
+        sift_up(size_++);
+    } else {
+        int slot = heap_[0];
+        std::copy(position, position + dim_, &pool_[(size_t)slot * dim_]);
+        fit_[slot] = fitness;
+        sift_down(0);
+    }
+    return true;
+}
+
+void EliteArchive::sift_up(int pos) {
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (!(fit_[heap_[parent]] < fit_[heap_[pos]])) break;
+        std::swap(heap_[parent], heap_[pos]);
+        pos = parent;
+    }
+}
+
+void EliteArchive::sift_down(int pos) {
+    for (;;) {
+        int largest = pos;
+        int l = 2 * pos + 1, r = l + 1;
+        if (l < size_ && fit_[heap_[largest]] < fit_[heap_[l]]) largest = l;
+        if (r < size_ && fit_[heap_[largest]] < fit_[heap_[r]]) largest = r;
+        if (largest == pos) break;
+        std::swap(heap_[pos], heap_[largest]);
+        pos = largest;
+    }
+}
+
+void EliteArchive::save(CheckpointWriter& out) const {
+    out.put(size_);
+    out.put_array(pool_.data(), (size_t)size_ * dim_);
+    out.put_array(fit_.data(), size_);
+    out.put_array(heap_.data(), size_);
+}
+
+void EliteArchive::restore(CheckpointReader& in) {
+    size_ = std::min(std::max(in.get<int>(), 0), capacity_);
+    in.get_array(pool_.data(), (size_t)size_ * dim_);
+    in.get_array(fit_.data(), size_);
+    in.get_array(heap_.data(), size_);
+}
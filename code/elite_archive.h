@@ -0,0 +1,51 @@
+// elite_archive.h
+#ifndef ELITE_ARCHIVE_H
+#define ELITE_ARCHIVE_H
+
+#include <cstdint>
+#include "arena.h"
+#include "checkpoint.h"
+
+// Archivo de élites de capacidad fija.
+// Las posiciones viven en un bloque preasignado (capacidad x D) y un
+// montículo de máximos de índices a ese bloque deja el peor élite en la
+// cima: una candidata que no mejora al peor se rechaza en O(1) y una que
+// entra lo sustituye en O(log k). No se admiten posiciones repetidas.
+class EliteArchive {
+public:
+    EliteArchive(int capacity, int dim, Arena& arena);
+
+    // Ofrece una candidata; devuelve true si entra en el archivo
+    bool offer(const double* position, double fitness);
+
+    int size() const { return size_; }
+    int capacity() const { return capacity_; }
+    bool full() const { return size_ == capacity_; }
+
+    // Élites por hueco, en [0, size())
+    const double* position(int slot) const { return &pool_[(size_t)slot * dim_]; }
+    double fitness(int slot) const { return fit_[slot]; }
+
+    // Fitness del peor élite (cima del montículo); requiere size() > 0
+    double worst_fitness() const { return fit_[heap_[0]]; }
+
+    void clear() { size_ = 0; }
+
+    // Contenido completo (élites y montículo), para los checkpoints
+    void save(CheckpointWriter& out) const;
+    void restore(CheckpointReader& in);
+
+private:
+    bool contains(const double* position, double fitness) const;
+    void sift_up(int pos);
+    void sift_down(int pos);
+
+    int capacity_;
+    int dim_;
+    int size_ = 0;
+    ArenaVector<double> pool_;   // capacidad x D
+    ArenaVector<double> fit_;    // fitness por hueco
+    ArenaVector<int> heap_;      // huecos, montículo de máximos por fitness
+};
+
+#endif // ELITE_ARCHIVE_H
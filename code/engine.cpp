@@ -0,0 +1,353 @@
+// engine.cpp
+#include "engine.h"
+#include "cec17.h"
+#include "optimizer.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <random>
+
+// Arena del hilo que ejecuta el motor: se rebobina al empezar cada ejecución
+// y conserva sus bloques para la siguiente
+static thread_local Arena engine_arena;
+
+static unsigned long long resolve_seed(unsigned long long seed) {
+    if (seed != 0) return seed;
+    return ((unsigned long long)std::random_device{}() << 32) | std::random_device{}();
+}
+
+void Engine::milestone(void* ctx, int milestone, double error) {
+    Engine& engine = *static_cast<Engine*>(ctx);
+    RunRecord& record = engine.record_;
+    if (record.milestones < RunRecord::MILESTONES) {
+        record.milestone[record.milestones] = milestone;
+        record.error[record.milestones] = error;
+        ++record.milestones;
+    }
+    if (engine.config_.on_milestone) engine.config_.on_milestone(milestone, error);
+}
+
+Engine::Engine(const EngineConfig& config)
+    : config_(config), cec_(cec17_context_new()), log_(config.log ? config.log : &std::cout),
+      seed_(resolve_seed(config.seed)), rng_(seed_),
+      best_position_fitness_(std::numeric_limits<double>::infinity()),
+      best_(std::numeric_limits<double>::infinity()),
+      reported_best_(std::numeric_limits<double>::infinity()),
+      print_step_(std::max(1LL, config.max_fes / 10)), next_print_(print_step_),
+      next_checkpoint_(config.checkpoint_fes) {
+    if (cec_ == nullptr) throw std::bad_alloc();
+    cec17_init_r(cec_, config_.alg_name.c_str(), config_.func_id, config_.dim);
+    if (config_.print_output) cec17_print_output_r(cec_);
+    else if (!config_.write_output) cec17_no_output_r(cec_);
+    if (config_.run > 0) cec17_set_run_r(cec_, config_.run);
+    if (config_.on_milestone || !config_.record_path.empty())
+        cec17_set_milestone_callback_r(cec_, milestone, this);
+    if (config_.num_threads != 1) pool_ = std::make_unique<ThreadPool>(config_.num_threads, cec17_thread_release);
+    if (!config_.trace_path.empty())
+        trace_ = std::make_unique<TraceRecorder>(config_.trace_capacity, config_.trace_schedule);
+    if (!config_.best_path.empty()) best_position_.resize(config_.dim);
+    if (!config_.snapshot_path.empty()) {
+        config_.snapshot_every = std::max(1, config_.snapshot_every);
+        dump_ = std::make_unique<SwarmDump>(config_.snapshot_encoding, config_.dim, config_.lower_bound,
+                                            config_.upper_bound, config_.snapshot_budget,
+                                            config_.snapshot_swarm);
+    }
+    for (const auto& policy : config_.termination)
+        needs_diversity_ = needs_diversity_ || policy->uses_diversity();
+    engine_arena.reset();
+}
+
+Engine::~Engine() {
+    cec17_context_free(cec_);
+}
+
+Arena& Engine::arena() { return engine_arena; }
+
+double Engine::run(Optimizer& optimizer) {
+    optimizer_name_ = optimizer.name();
+    optimizer_key_ = optimizer.state_key();
+    start_ = std::chrono::steady_clock::now();
+    bind_phases();
+    if (!config_.checkpoint_path.empty()) resumed_ = load_checkpoint();
+    log(LogLevel::INFO) << "Semilla: " << seed_ << "\n";
+    log_event(LogLevel::INFO, LogEventKind::START);
+    if (resumed_) {
+        log(LogLevel::INFO) << "Reanudando desde " << config_.checkpoint_path << " (FEs: " << fes_ << ")\n";
+        log_event(LogLevel::INFO, LogEventKind::RESUME, config_.checkpoint_path.c_str());
+    }
+    optimizer.optimize(*this);
+    // Los milestones que faltan llevan el mejor del momento de la parada
+    if (stopped_) cec17_finish_r(cec_);
+    cec17_flush_r(cec_);
+    if (trace_) trace_->write(config_.trace_path, config_.func_id, config_.dim, config_.max_fes, seed_);
+    if (!config_.record_path.empty()) {
+        record_.func_id = config_.func_id;
+        record_.dim = config_.dim;
+        record_.seed = seed_;
+        record_.max_fes = config_.max_fes;
+        append_run_record(config_.record_path, record_);
+    }
+    if (!config_.best_path.empty() && best_position_fitness_ < std::numeric_limits<double>::infinity())
+        write_best_position(config_.best_path, config_.func_id, config_.dim, seed_, fes_,
+                            best_position_fitness_, best_position_.data());
+    if (dump_) dump_->write(config_.snapshot_path, config_.func_id, seed_);
+    // Terminada: el checkpoint ya no hace falta
+    if (!config_.checkpoint_path.empty()) std::remove(config_.checkpoint_path.c_str());
+    unbind_phases();
+    log_event(LogLevel::INFO, LogEventKind::SUMMARY);
+    if (logs(LogLevel::INFO)) {
+        *log_ << "Final best F" << config_.func_id << " D" << config_.dim
+                  << ": " << std::scientific << best_
+                  << " (FEs: " << fes_ << ")\n";
+        *log_ << "Error: " << std::scientific << cec17_error_r(cec_, best_) << "\n";
+        phases_.report(*log_, fes_);
+    }
+    return best_;
+}
+
+double Engine::evaluate_uncounted(const double* sol) const {
+    PHASE_SCOPE(Phase::EVALUATION);
+    return cec17_evaluate(const_cast<double*>(sol), config_.func_id, config_.dim);
+}
+
+double Engine::commit(double fitness, const double* position) {
+    cec17_register_r(cec_, fitness);
+    ++fes_;
+    bool improved = fitness < best_;
+    if (improved) {
+        best_ = fitness;
+        improved_fes_ = fes_;
+        if (position && !best_position_.empty()) {
+            std::copy(position, position + config_.dim, best_position_.begin());
+            best_position_fitness_ = fitness;
+        }
+    }
+    if (trace_) trace_->record(fes_, fitness, best_, improved);
+    return fitness;
+}
+
+void Engine::offer_best(const double* position, double fitness) {
+    if (best_position_.empty() || !(fitness < best_position_fitness_)) return;
+    std::copy(position, position + config_.dim, best_position_.begin());
+    best_position_fitness_ = fitness;
+}
+
+int Engine::evaluate_batch(const double* sols, int n, std::size_t stride, double* fitness) {
+    n = (int)std::min<long long>(n, remaining());
+    if (n <= 0) return 0;
+    if (pool_) {
+        pool_->parallel_for(n, [&](int i) { fitness[i] = evaluate_uncounted(sols + i * stride); });
+        for (int i = 0; i < n; ++i) commit(fitness[i], sols + i * stride);
+    } else {
+        for (int i = 0; i < n; ++i) fitness[i] = evaluate(sols + i * stride);
+    }
+    return n;
+}
+
+static double engine_ls_evaluate(void* ctx, double* sol) {
+    return static_cast<Engine*>(ctx)->evaluate(sol);
+}
+
+static void engine_ls_evaluate_pair(void* ctx, double* a, double* b, double* fa, double* fb) {
+    auto* engine = static_cast<Engine*>(ctx);
+    engine->pool()->parallel_for(2, [&](int i) {
+        PHASE_SCOPE(Phase::LOCAL_SEARCH);
+        if (i == 0) *fa = engine->evaluate_uncounted(a);
+        else        *fb = engine->evaluate_uncounted(b);
+    });
+    engine->commit(*fa, a);
+    engine->commit(*fb, b);
+}
+
+LsEvaluator Engine::ls_evaluator() {
+    return LsEvaluator{engine_ls_evaluate, pool_ ? engine_ls_evaluate_pair : nullptr, this};
+}
+
+void Engine::report_progress(double diversity) {
+    PHASE_SCOPE(Phase::LOGGING);
+    if (!stopped_ && !config_.termination.empty() && fes_ > 0) {
+        TerminationState state{fes_, fes_ - improved_fes_, cec17_error_r(cec_, best_), elapsed(), diversity};
+        for (const auto& policy : config_.termination) {
+            if (!policy->done(state)) continue;
+            stopped_ = true;
+            log_event(LogLevel::INFO, LogEventKind::STOP, policy->name());
+            log(LogLevel::INFO) << "⏹️ Parada por " << policy->name() << " en FEs=" << fes_
+                                << " de " << config_.max_fes << ", error " << std::scientific << state.error << "\n";
+            break;
+        }
+    }
+    if (best_ < reported_best_) {
+        if (reported_best_ < std::numeric_limits<double>::infinity()) {
+            if (logs(LogLevel::DEBUG)) *log_ << "Mejora global: " << std::scientific << best_ << " en FEs=" << fes_ << "\n";
+            log_event(LogLevel::DEBUG, LogEventKind::IMPROVEMENT);
+        }
+        reported_best_ = best_;
+    }
+    if (fes_ >= next_print_) {
+        if (logs(LogLevel::DEBUG)) *log_ << "FEs " << fes_ << ", best: " << std::scientific << best_ << "\n";
+        log_event(LogLevel::DEBUG, LogEventKind::PROGRESS);
+        while (next_print_ <= fes_) next_print_ += print_step_;
+    }
+}
+
+// Cada hilo del pool recibe uno de los size() índices (parallel_for_static)
+void Engine::bind_phases() {
+    if (!PhaseProfile::enabled) return;
+    phases_.set_hw_counters(config_.hw_counters);
+    phases_.bind(true);
+    if (pool_) pool_->parallel_for_static(pool_->size(), [this](int t) { if (t > 0) phases_.bind(); });
+}
+
+void Engine::unbind_phases() {
+    if (!PhaseProfile::enabled) return;
+    if (pool_) pool_->parallel_for_static(pool_->size(), [this](int t) { if (t > 0) phases_.unbind(); });
+    phases_.unbind();
+}
+
+double Engine::elapsed() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+}
+
+void Engine::log_event(LogLevel level, LogEventKind kind, const char* text) {
+    if (config_.events == nullptr || !config_.events->enabled(level)) return;
+    LogEvent e{};
+    e.level = level;
+    e.kind = kind;
+    e.func_id = config_.func_id;
+    e.dim = config_.dim;
+    e.seed = seed_;
+    e.fes = fes_;
+    e.max_fes = config_.max_fes;
+    e.best = best_;
+    e.error = fes_ > 0 ? cec17_error_r(cec_, best_) : std::numeric_limits<double>::quiet_NaN();
+    e.seconds = elapsed();
+    std::strncpy(e.alg, config_.alg_name.c_str(), sizeof(e.alg) - 1);
+    std::strncpy(e.text, text, sizeof(e.text) - 1);
+    config_.events->record(e);
+}
+
+// Cabecera del checkpoint: formato y configuración a la que pertenece
+static const std::uint32_t CHECKPOINT_MAGIC = 0x4B434646;   // "FFCK"
+static const std::uint32_t CHECKPOINT_VERSION = 6;
+static const int CHECKPOINT_NAME = 32;
+
+// Tamaño del fichero de milestones, o -1 si la ejecución no escribe en él
+static long long results_size(const EngineConfig& config, cec17_context* cec) {
+    if (config.print_output || !config.write_output) return -1;
+    cec17_flush_r(cec);
+    std::error_code ec;
+    auto size = std::filesystem::file_size(cec17_output_file_r(cec), ec);
+    return ec ? 0 : (long long)size;
+}
+
+void Engine::begin_checkpoint() {
+    CheckpointWriter& out = checkpoint_out_;
+    out.clear();
+    char name[CHECKPOINT_NAME] = {};
+    std::strncpy(name, optimizer_name_, CHECKPOINT_NAME - 1);
+    out.put(CHECKPOINT_MAGIC);
+    out.put(CHECKPOINT_VERSION);
+    out.put(config_.func_id);
+    out.put(config_.dim);
+    out.put(config_.max_fes);
+    out.put_array(name, CHECKPOINT_NAME);
+    out.put(optimizer_key_);
+    out.put(seed_);
+    out.put(rng_.state());
+    out.put(fes_);
+    out.put(best_);
+    out.put(reported_best_);
+    out.put(next_print_);
+    out.put(improved_fes_);
+    int evals, milestones;
+    double best;
+    cec17_get_progress_r(cec_, &evals, &best, &milestones);
+    out.put(evals);
+    out.put(best);
+    out.put(milestones);
+    out.put(results_size(config_, cec_));
+    out.put((long long)(trace_ ? trace_->capacity() : 0));
+    out.put((long long)(trace_ ? trace_->schedule_size() : 0));
+    out.put((long long)best_position_.size());
+    out.put(dump_ != nullptr);
+    if (trace_) trace_->save(out);
+    out.put(record_);
+    out.put_array(best_position_.data(), best_position_.size());
+    out.put(best_position_fitness_);
+    if (dump_) dump_->save(out);
+}
+
+void Engine::end_checkpoint() {
+    if (checkpoint_out_.save(config_.checkpoint_path)) {
+        log_event(LogLevel::DEBUG, LogEventKind::CHECKPOINT, config_.checkpoint_path.c_str());
+    } else {
+        log(LogLevel::WARN) << "⚠️ No se puede escribir el checkpoint " << config_.checkpoint_path << "\n";
+        log_event(LogLevel::WARN, LogEventKind::WARNING, "no se puede escribir el checkpoint");
+    }
+    while (next_checkpoint_ <= fes_) next_checkpoint_ += std::max(1LL, config_.checkpoint_fes);
+}
+
+bool Engine::load_checkpoint() {
+    CheckpointReader& in = checkpoint_in_;
+    if (!std::filesystem::exists(config_.checkpoint_path)) return false;
+    // Uno que no se puede leer o está dañado se descarta igual que uno de
+    // otra configuración
+    in.load(config_.checkpoint_path);
+
+    char name[CHECKPOINT_NAME] = {};
+    bool same = in.get<std::uint32_t>() == CHECKPOINT_MAGIC
+             && in.get<std::uint32_t>() == CHECKPOINT_VERSION
+             && in.get<int>() == config_.func_id
+             && in.get<int>() == config_.dim
+             && in.get<long long>() == config_.max_fes;
+    in.get_array(name, CHECKPOINT_NAME);
+    same = same && std::strncmp(name, optimizer_name_, CHECKPOINT_NAME - 1) == 0
+                && in.get<std::uint64_t>() == optimizer_key_;
+    auto seed = in.get<unsigned long long>();
+    auto rng = in.get<Rng::State>();
+    auto fes = in.get<long long>();
+    auto best = in.get<double>();
+    auto reported_best = in.get<double>();
+    auto next_print = in.get<long long>();
+    auto improved_fes = in.get<long long>();
+    auto evals = in.get<int>();
+    auto cec_best = in.get<double>();
+    auto milestones = in.get<int>();
+    auto size = in.get<long long>();
+    same = same && in.get<long long>() == (long long)(trace_ ? trace_->capacity() : 0)
+                && in.get<long long>() == (long long)(trace_ ? trace_->schedule_size() : 0)
+                && in.get<long long>() == (long long)best_position_.size()
+                && in.get<bool>() == (dump_ != nullptr);
+
+    // Los milestones escritos tras el checkpoint se descartan; si falta
+    // alguno de antes, la ejecución no se puede reanudar
+    long long current = results_size(config_, cec_);
+    if (!same || !in.ok() || fes != evals || current < size) {
+        log(LogLevel::WARN) << "⚠️ Checkpoint no válido: " << config_.checkpoint_path << " → empezando de cero\n";
+        log_event(LogLevel::WARN, LogEventKind::WARNING, "checkpoint no válido");
+        if (current > 0) std::filesystem::remove(cec17_output_file_r(cec_));
+        return false;
+    }
+    if (current > size) std::filesystem::resize_file(cec17_output_file_r(cec_), (std::uintmax_t)size);
+
+    seed_ = seed;
+    rng_.restore(rng);
+    fes_ = fes;
+    best_ = best;
+    reported_best_ = reported_best;
+    next_print_ = next_print;
+    improved_fes_ = improved_fes;
+    cec17_set_progress_r(cec_, evals, cec_best, milestones);
+    if (trace_) trace_->restore(in);
+    record_ = in.get<RunRecord>();
+    in.get_array(best_position_.data(), best_position_.size());
+    best_position_fitness_ = in.get<double>();
+    if (dump_) dump_->restore(in);
+    next_checkpoint_ = fes_ + config_.checkpoint_fes;
+    return true;
+}
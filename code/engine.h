@@ -0,0 +1,205 @@
+// engine.h
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include "arena.h"
+#include "checkpoint.h"
+#include "event_log.h"
+#include "phase_timer.h"
+#include "rng.h"
+#include "run_record.h"
+#include "solution_dump.h"
+#include "soliswets.h"
+#include "termination.h"
+#include "thread_pool.h"
+#include "trace.h"
+#include <vector>
+
+class Optimizer;
+struct cec17_context;
+
+struct EngineConfig {
+    EngineConfig(int dim, int func_id, std::string alg_name, long long max_fes)
+        : dim(dim), func_id(func_id), alg_name(std::move(alg_name)), max_fes(max_fes) {}
+
+    int dim;
+    int func_id;
+    std::string alg_name;         // resultados en results_<alg_name>
+    long long max_fes;
+    double lower_bound = -100.0;
+    double upper_bound = 100.0;
+    unsigned long long seed = 0;  // 0 = aleatoria
+    int num_threads = 1;          // 1 = sin pool, 0 = todos los núcleos
+    bool print_output = false;    // milestones por pantalla (cec17_print_output)
+    bool write_output = true;     // false: milestones solo a on_milestone
+    int run = 0;                  // > 0: columna run en el fichero (cec17_set_run)
+    std::function<void(int milestone, double error)> on_milestone;
+    bool verbose = true;          // mensajes por pantalla
+    LogLevel log_level = LogLevel::INFO;   // nivel de los mensajes por pantalla (log)
+    std::ostream* log = nullptr;  // destino de los mensajes (nulo = std::cout)
+    EventLog* events = nullptr;   // registro JSON compartido (nulo = sin él)
+    std::string checkpoint_path;  // vacío = sin checkpoints
+    long long checkpoint_fes = 0; // evaluaciones entre checkpoints
+    // Paradas anticipadas; basta con que se cumpla una
+    std::vector<std::shared_ptr<const TerminationPolicy>> termination;
+    std::string trace_path;       // traza de convergencia (vacío = sin traza)
+    TraceSchedule trace_schedule; // además de cada mejora
+    std::size_t trace_capacity = 1 << 16;   // mejoras que caben
+    std::string record_path;      // registro binario al terminar (run_record.h)
+    bool hw_counters = false;     // contadores hardware por fase (FIREFLY_PROFILE)
+    std::string best_path;        // mejor posición al terminar (solution_dump.h)
+    std::string snapshot_path;    // instantáneas del enjambre (vacío = sin ellas)
+    int snapshot_every = 1;       // generaciones entre instantáneas
+    SnapshotEncoding snapshot_encoding = SnapshotEncoding::FLOAT32;
+    std::size_t snapshot_budget = 16 << 20;   // bytes como mucho
+    int snapshot_swarm = 0;       // luciérnagas como mucho en una instantánea
+};
+
+// Motor común de una ejecución: contexto del evaluador CEC17, generador,
+// presupuesto de evaluaciones, arena, pool de hilos y mensajes de progreso.
+// Cualquier Optimizer se ejecuta igual, así que lo que se mejore aquí (hilos,
+// lotes...) lo aprovechan todos los algoritmos.
+//
+// Todas las evaluaciones se contabilizan en el hilo del motor y en orden, de
+// modo que el contador de FEs y los milestones no dependen de los hilos.
+class Engine {
+public:
+    explicit Engine(const EngineConfig& config);
+    ~Engine();
+
+    Engine(const Engine&) = delete;
+    Engine& operator=(const Engine&) = delete;
+
+    // Ejecuta el algoritmo, muestra el resumen y devuelve el mejor fitness
+    double run(Optimizer& optimizer);
+
+    int dim() const { return config_.dim; }
+    int func_id() const { return config_.func_id; }
+    double lower_bound() const { return config_.lower_bound; }
+    double upper_bound() const { return config_.upper_bound; }
+    bool verbose() const { return config_.verbose; }
+    // Destino de los mensajes de ese nivel: sin verbose, o si log_level no
+    // llega a él, un flujo que los descarta
+    bool logs(LogLevel level) const { return config_.verbose && level <= config_.log_level; }
+    std::ostream& log(LogLevel level) { return logs(level) ? *log_ : quiet_; }
+    unsigned long long seed() const { return seed_; }
+
+    long long max_fes() const { return config_.max_fes; }
+    long long fes() const { return fes_; }
+    // Tras una parada anticipada no queda presupuesto
+    long long remaining() const { return stopped_ ? 0 : config_.max_fes - fes_; }
+    bool exhausted() const { return stopped_ || fes_ >= config_.max_fes; }
+    bool stopped() const { return stopped_; }
+
+    Rng& rng() { return rng_; }
+    Arena& arena();
+    ThreadPool* pool() { return pool_.get(); }   // nulo si es secuencial
+    // Tiempos por fase (FIREFLY_PROFILE): el hilo del motor y los del pool
+    // ya acumulan aquí; los hilos propios del algoritmo usan PhaseThread
+    PhaseProfile& phases() { return phases_; }
+
+    // Evalúa y contabiliza una solución
+    double evaluate(const double* sol) { return commit(evaluate_uncounted(sol), sol); }
+
+    // Evalúa sin contabilizar. Reentrante: se puede llamar desde el pool,
+    // y cada resultado se contabiliza luego con commit en el orden deseado.
+    // Con position, si mejora el mejor y se guarda (best_path) se copia.
+    double evaluate_uncounted(const double* sol) const;
+    double commit(double fitness, const double* position = nullptr);
+
+    // Mejor posición hallada fuera de commit (islas): se guarda si mejora
+    // la que ya hay
+    void offer_best(const double* position, double fitness);
+
+    // Evalúa n soluciones (la i empieza en sols + i*stride), en paralelo si
+    // hay pool, y las contabiliza en orden. No pasa del presupuesto:
+    // devuelve cuántas se han evaluado.
+    int evaluate_batch(const double* sols, int n, std::size_t stride, double* fitness);
+
+    // Evaluador para soliswets(); con pool, las sondas + y - de batch_pair
+    // se evalúan a la vez
+    LsEvaluator ls_evaluator();
+
+    double best_fitness() const { return best_; }
+
+    // Instantánea del enjambre si toca en esta generación (snapshot_path)
+    template <class P, class F>
+    void snapshot(long long generation, int n, P&& position, F&& fitness) {
+        if (dump_ && generation % config_.snapshot_every == 0)
+            dump_->add(generation, fes_, n, position, fitness);
+    }
+
+    // Mensajes de progreso (nivel DEBUG): mejora del mejor global desde el
+    // último aviso y el mejor cada 10% del presupuesto. Se llama una vez por iteración;
+    // la primera llamada solo fija la referencia. También comprueba las
+    // paradas anticipadas, con la diversidad que mida el algoritmo si
+    // alguna la usa (needs_diversity).
+    void report_progress(double diversity = std::numeric_limits<double>::quiet_NaN());
+    bool needs_diversity() const { return needs_diversity_; }
+
+    // Checkpoints. Si al empezar hay uno de esta configuración y algoritmo
+    // (nombre y state_key), run() restaura el estado del motor (generador,
+    // FEs, milestones) y recorta el fichero de resultados a lo escrito hasta
+    // entonces; resume() devuelve el lector colocado en el estado del
+    // algoritmo, o nulo. Uno de otra configuración o dañado se descarta y la
+    // ejecución empieza de cero.
+    CheckpointReader* resume() { return resumed_ ? &checkpoint_in_ : nullptr; }
+    bool checkpoint_due() const {
+        return !config_.checkpoint_path.empty() && fes_ >= next_checkpoint_ && !exhausted();
+    }
+    // Guarda el estado del motor seguido del que escriba save(writer)
+    template <class F>
+    void checkpoint(F&& save) {
+        begin_checkpoint();
+        save(checkpoint_out_);
+        end_checkpoint();
+    }
+
+private:
+    static void milestone(void* ctx, int milestone, double error);
+    bool load_checkpoint();
+    void log_event(LogLevel level, LogEventKind kind, const char* text = "");
+    double elapsed() const;
+    void bind_phases();
+    void unbind_phases();
+    void begin_checkpoint();
+    void end_checkpoint();
+
+    EngineConfig config_;
+    cec17_context* cec_;          // contador y milestones de esta ejecución
+    std::ostream* log_;
+    std::ostream quiet_{nullptr}; // sin buffer: lo que se escribe se descarta
+    unsigned long long seed_;
+    Rng rng_;
+    std::unique_ptr<ThreadPool> pool_;
+    std::unique_ptr<TraceRecorder> trace_;
+    RunRecord record_{};          // milestones de esta ejecución
+    std::vector<double> best_position_;   // vacío si no se guarda
+    double best_position_fitness_;
+    std::unique_ptr<SwarmDump> dump_;
+    PhaseProfile phases_;
+    long long fes_ = 0;
+    double best_;
+    double reported_best_;
+    long long print_step_;
+    long long next_print_;
+    const char* optimizer_name_ = "";
+    std::uint64_t optimizer_key_ = 0;
+    CheckpointReader checkpoint_in_;
+    CheckpointWriter checkpoint_out_;
+    bool resumed_ = false;
+    long long next_checkpoint_;
+    long long improved_fes_ = 0;   // FEs en la última mejora del mejor
+    bool needs_diversity_ = false;
+    bool stopped_ = false;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#endif // ENGINE_H
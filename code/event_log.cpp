@@ -0,0 +1,108 @@
+// event_log.cpp
+#include "event_log.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+// Espera del hilo escritor cuando la cola está vacía
+static const auto EVENT_LOG_IDLE = std::chrono::milliseconds(2);
+
+static const char* LOG_LEVEL_NAMES[] = {"error", "warn", "info", "debug"};
+static const char* LOG_EVENT_NAMES[] = {"start", "resume", "improvement", "progress",
+                                        "checkpoint", "stop", "warning", "summary"};
+
+bool parse_log_level(const std::string& name, LogLevel& level) {
+    for (int i = 0; i < 4; ++i)
+        if (name == LOG_LEVEL_NAMES[i]) {
+            level = static_cast<LogLevel>(i);
+            return true;
+        }
+    return false;
+}
+
+EventLog::EventLog(const std::string& path, LogLevel level, std::size_t capacity)
+    : level_(level), queue_(capacity) {
+    out_ = std::fopen(path.c_str(), "a");
+    if (out_ == nullptr) {
+        std::cerr << "Error: no se puede escribir " << path << "\n";
+        return;
+    }
+    writer_ = std::thread([this] { writer_loop(); });
+}
+
+EventLog::~EventLog() {
+    if (out_ == nullptr) return;
+    stop_.store(true, std::memory_order_release);
+    writer_.join();
+    std::fclose(out_);
+}
+
+void EventLog::writer_loop() {
+    LogEvent event;
+    for (;;) {
+        bool stopping = stop_.load(std::memory_order_acquire);
+        bool wrote = false;
+        while (queue_.pop(event)) {
+            write(event);
+            wrote = true;
+        }
+        long long dropped = dropped_.load(std::memory_order_relaxed);
+        if (dropped != reported_dropped_) {
+            std::fprintf(out_, "{\"level\":\"warn\",\"event\":\"dropped\",\"count\":%lld}\n",
+                         dropped - reported_dropped_);
+            reported_dropped_ = dropped;
+            wrote = true;
+        }
+        if (wrote) std::fflush(out_);
+        // Lo encolado antes de pedir la parada ya se ha escrito
+        if (stopping) return;
+        if (!wrote) std::this_thread::sleep_for(EVENT_LOG_IDLE);
+    }
+}
+
+// Cadena JSON: comillas, barras y caracteres de control escapados
+static void put_string(FILE* out, const char* s) {
+    std::fputc('"', out);
+    for (; *s; ++s) {
+        unsigned char c = static_cast<unsigned char>(*s);
+        if (c == '"' || c == '\\') std::fprintf(out, "\\%c", c);
+        else if (c < 0x20) std::fprintf(out, "\\u%04x", c);
+        else std::fputc(c, out);
+    }
+    std::fputc('"', out);
+}
+
+// Los no finitos no existen en JSON
+static void put_number(FILE* out, const char* key, double value) {
+    if (std::isfinite(value)) std::fprintf(out, ",\"%s\":%.17g", key, value);
+    else std::fprintf(out, ",\"%s\":null", key);
+}
+
+void EventLog::write(const LogEvent& e) {
+    std::fprintf(out_, "{\"level\":\"%s\",\"event\":\"%s\",\"alg\":",
+                 LOG_LEVEL_NAMES[static_cast<int>(e.level)], LOG_EVENT_NAMES[static_cast<int>(e.kind)]);
+    put_string(out_, e.alg);
+    std::fprintf(out_, ",\"func\":%d,\"dim\":%d,\"seed\":%llu,\"fes\":%lld", e.func_id, e.dim, e.seed, e.fes);
+    switch (e.kind) {
+        case LogEventKind::START:
+            std::fprintf(out_, ",\"max_fes\":%lld", e.max_fes);
+            break;
+        case LogEventKind::IMPROVEMENT:
+        case LogEventKind::PROGRESS:
+        case LogEventKind::SUMMARY:
+            put_number(out_, "best", e.best);
+            put_number(out_, "error", e.error);
+            break;
+        case LogEventKind::STOP:
+            put_number(out_, "error", e.error);
+            break;
+        default:
+            break;
+    }
+    if (e.text[0]) {
+        std::fputs(e.kind == LogEventKind::STOP ? ",\"reason\":" : ",\"message\":", out_);
+        put_string(out_, e.text);
+    }
+    std::fprintf(out_, ",\"seconds\":%.6f", e.seconds);
+    std::fputs("}\n", out_);
+}
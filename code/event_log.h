@@ -0,0 +1,83 @@
+// event_log.h
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include "mpsc_queue.h"
+
+// Niveles de los mensajes de una ejecución, por pantalla y en el registro
+// JSON. Por defecto (INFO) salen los avisos y los resúmenes; WARN deja solo
+// los avisos y ERROR solo los errores. DEBUG añade las mejoras y el
+// progreso, que se generan en el bucle de evaluación.
+enum class LogLevel { ERROR, WARN, INFO, DEBUG };
+
+// false si name no es un nivel (error, warn, info, debug)
+bool parse_log_level(const std::string& name, LogLevel& level);
+
+enum class LogEventKind {
+    START,         // configuración de la ejecución
+    RESUME,        // reanudada desde un checkpoint
+    IMPROVEMENT,   // nuevo mejor global
+    PROGRESS,      // mejor cada 10% del presupuesto
+    CHECKPOINT,    // checkpoint guardado
+    STOP,          // parada anticipada (text = política)
+    WARNING,       // text = aviso
+    SUMMARY        // resultado final
+};
+
+// Registro de tamaño fijo, para copiarlo a la cola sin reservar memoria.
+// Los textos se truncan.
+struct LogEvent {
+    LogLevel level;
+    LogEventKind kind;
+    int func_id;
+    int dim;
+    unsigned long long seed;
+    long long fes;
+    long long max_fes;
+    double best;
+    double error;
+    double seconds;      // desde el inicio de la ejecución
+    char alg[48];
+    char text[96];
+};
+
+// Registro estructurado de las ejecuciones: una línea JSON por evento.
+// Los motores (desde cualquier hilo) dejan los eventos en una cola sin
+// bloqueos y un único hilo los formatea y escribe, así que registrar no
+// toma el cerrojo de la salida ni espera a la escritura. Si la cola se
+// llena el evento se descarta y se cuenta.
+class EventLog {
+public:
+    // Abre (añadiendo) path; si no se puede, ok() es false y no registra nada
+    EventLog(const std::string& path, LogLevel level, std::size_t capacity = 1 << 14);
+    ~EventLog();   // escribe lo pendiente
+
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    bool ok() const { return out_ != nullptr; }
+    LogLevel level() const { return level_; }
+    bool enabled(LogLevel level) const { return out_ != nullptr && level <= level_; }
+
+    void record(const LogEvent& event) {
+        if (!queue_.push(event)) dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:
+    void writer_loop();
+    void write(const LogEvent& event);
+
+    FILE* out_ = nullptr;
+    LogLevel level_;
+    MpscQueue<LogEvent> queue_;
+    std::atomic<long long> dropped_{0};
+    long long reported_dropped_ = 0;
+    std::atomic<bool> stop_{false};
+    std::thread writer_;
+};
+
+#endif // EVENT_LOG_H
@@ -23,7 +23,9 @@ def main():
     os.chdir(dir)
     path = Path('.')
 
-    fnames = [file.name for file in path.iterdir() if "txt" in file.name]
+    # Solo los milestones: no manifest.txt ni stats_*.txt
+    fnames = [file.name for file in path.iterdir()
+              if file.name.startswith("results_") and file.name.endswith(".txt")]
     globaldf = pd.DataFrame({"funcid": [], "dim": [], "milestone": [], "error": []})
     dict = {"milestone": []}
 
@@ -34,6 +36,8 @@ def main():
 
     for fname in fnames:
         df = pd.read_csv(fname)
+        # --raw: la columna run solo distingue las ejecuciones
+        df = df.drop(columns=["run"], errors="ignore")
         globaldf = pd.concat([globaldf, df], ignore_index=True)
 
     def funformat(funid):
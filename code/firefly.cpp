@@ -1,144 +1,939 @@
 // firefly.cpp
 #include "firefly.h"
+#include "engine.h"
 #include "cec17.h"
+#include "alloc_counter.h"
+#include "elite_archive.h"
+#include "soliswets.h"
+#include "ls_scheduler.h"
+#include "migrant_queue.h"
+#include "result_cache.h"
+#include "bounded_queue.h"
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <thread>
 #include <vector>
-#include <random>
 #include <limits>
 #include <cmath>
 #include <algorithm>
-
-// Generadores globales
-static long long current_fes_counter = 0;
-static std::mt19937 gen{std::random_device{}()};
-static std::uniform_real_distribution<> dis(0.0, 1.0);
+#include <memory>
+#include <cstdlib>
 
 inline double clamp_val(double x, double lo, double hi) {
     return std::min(std::max(x, lo), hi);
 }
 
-void initialize_firefly(Firefly& ff, int dim, double lo, double hi) {
+void initialize_firefly(Firefly& ff, int dim, double lo, double hi, Rng& rng) {
     ff.position.resize(dim);
-    for (int i = 0; i < dim; ++i) ff.position[i] = lo + (hi - lo) * dis(gen);
+    rng.fill_uniform(ff.position.data(), dim);
+    for (int i = 0; i < dim; ++i) ff.position[i] = lo + (hi - lo) * ff.position[i];
     ff.fitness = std::numeric_limits<double>::infinity();
 }
 
-void evaluate_firefly(Firefly& ff) {
-    ff.fitness = cec17_fitness(ff.position.data());
-    ++current_fes_counter;
+void evaluate_firefly(Firefly& ff, Engine& engine) {
+    ff.fitness = engine.evaluate(ff.position.data());
 }
 
+// Buffers de una ejecución, reservados una sola vez al principio en la
+// arena para que el bucle de generaciones no reserve memoria
+struct FireflyWorkspace {
+    ArenaVector<Firefly> swarm;
+    Firefly best;                   // copia del mejor, solo al mejorar
+    ArenaVector<double> rnd;        // pasos aleatorios de la generación (N x D)
+    ArenaVector<double> moves;      // atracción de cada luciérnaga (N x D)
+    ArenaVector<Firefly> shadow;    // copia congelada (síncrona) / especulaciones
+    ArenaVector<double> old_fit;    // ejecución especulativa
+    ArenaVector<int> base, todo;
+    ArenaVector<char> reexecuted;
+    Position ls_delta, ls_probe;
+    Position sw_bias, sw_dif, sw_newsol;  // Solis-Wets (newsol: sondas + y -)
+    Position centroid;              // diversidad del enjambre
+    EliteArchive archive;
+
+    FireflyWorkspace(int n, int dim, int archive_size, Arena& arena)
+        : swarm(n, Firefly{Position(dim, ArenaAllocator<double>(&arena)), 0.0},
+                ArenaAllocator<Firefly>(&arena)),
+          best{Position(dim, ArenaAllocator<double>(&arena)), std::numeric_limits<double>::infinity()},
+          rnd((size_t)n*dim, ArenaAllocator<double>(&arena)),
+          moves((size_t)n*dim, ArenaAllocator<double>(&arena)),
+          shadow(n, Firefly{Position(dim, ArenaAllocator<double>(&arena)), 0.0},
+                 ArenaAllocator<Firefly>(&arena)),
+          old_fit(n, ArenaAllocator<double>(&arena)),
+          base(n, ArenaAllocator<int>(&arena)), todo(n, ArenaAllocator<int>(&arena)),
+          reexecuted(n, ArenaAllocator<char>(&arena)),
+          ls_delta(dim, ArenaAllocator<double>(&arena)), ls_probe(dim, ArenaAllocator<double>(&arena)),
+          sw_bias(dim, ArenaAllocator<double>(&arena)), sw_dif(dim, ArenaAllocator<double>(&arena)),
+          sw_newsol(2*dim, ArenaAllocator<double>(&arena)),
+          centroid(dim, ArenaAllocator<double>(&arena)),
+          archive(archive_size, dim, arena) {}
+};
+
 // Memetic Solis-Wets local search
-void memetic_local_search(Firefly& ff, const FireflyParams& params) {
+// probe coincide con ff salvo en la coordenada que se prueba.
+// Gasta como mucho max_evals evaluaciones de eval y devuelve las usadas.
+long long memetic_local_search(Firefly& ff, const FireflyParams& params, Rng& rng,
+                               Position& delta, Position& probe, long long max_evals,
+                               const LsEvaluator& eval) {
     int dim = ff.position.size();
     double sigma = (params.upper_bound - params.lower_bound) * 0.1;
-    std::vector<double> delta(dim, sigma);
-    std::vector<double> probe(dim);
+    std::fill(delta.begin(), delta.end(), sigma);
+    probe = ff.position;
     double best = ff.fitness;
+    long long evals = 0;
 
     while (std::any_of(delta.begin(), delta.end(), [](double d){return d>1e-6;}) 
-           && current_fes_counter < params.max_fes) {
-        for (int i = 0; i < dim; ++i) {
-            std::normal_distribution<> nd(0.0, delta[i]);
-            probe = ff.position;
-            probe[i] = clamp_val(probe[i] + nd(gen), params.lower_bound, params.upper_bound);
-            Firefly temp{probe, std::numeric_limits<double>::infinity()};
-            evaluate_firefly(temp);
-            if (temp.fitness < best) {
-                ff = temp;
-                best = temp.fitness;
+           && evals < max_evals) {
+        for (int i = 0; i < dim && evals < max_evals; ++i) {
+            probe[i] = clamp_val(ff.position[i] + rng.normal(0.0, delta[i]),
+                                 params.lower_bound, params.upper_bound);
+            double fit = eval.evaluate(eval.ctx, probe.data());
+            ++evals;
+            if (fit < best) {
+                ff.position[i] = probe[i];
+                ff.fitness = fit;
+                best = fit;
                 delta[i] *= 1.2;
             } else {
+                probe[i] = ff.position[i];
                 delta[i] *= 0.5;
             }
         }
     }
+    return evals;
 }
 
 // Elitist archive with reinjection
-void elitist_archive(std::vector<Firefly>& swarm,
-                     std::vector<Firefly>& archive,
-                     int size) {
-    archive.insert(archive.end(), swarm.begin(), swarm.end());
-    std::sort(archive.begin(), archive.end(), [](auto& a, auto& b){return a.fitness<b.fitness;});
-    if ((int)archive.size()>size) archive.resize(size);
-    if (!archive.empty()) {
-        std::uniform_int_distribution<> ud(0, archive.size()-1);
-        int idx = ud(gen);
-        auto worst_it = std::max_element(swarm.begin(), swarm.end(),
-                             [](auto& a, auto& b){return a.fitness<b.fitness;});
-        *worst_it = archive[idx];
+// worst es el índice de la peor luciérnaga (locate_extremes)
+void elitist_archive(ArenaVector<Firefly>& swarm, EliteArchive& archive,
+                     size_t worst, Rng& rng) {
+    for (const auto& ff : swarm) archive.offer(ff.position.data(), ff.fitness);
+    if (archive.size()>0) {
+        int slot = rng.uniform_int(0, archive.size()-1);
+        Firefly& fw = swarm[worst];
+        std::copy(archive.position(slot), archive.position(slot)+fw.position.size(),
+                  fw.position.begin());
+        fw.fitness = archive.fitness(slot);
     }
 }
 
+// Diversidad del enjambre: distancia media al centroide, relativa al ancho
+// del dominio (0 = colapsado en un punto)
+static double swarm_diversity(FireflyWorkspace& ws, const FireflyParams& params) {
+    auto& c = ws.centroid;
+    std::fill(c.begin(), c.end(), 0.0);
+    for(const auto& ff:ws.swarm)
+        for(size_t k=0;k<c.size();++k) c[k]+=ff.position[k];
+    for(double& x:c) x/=ws.swarm.size();
+    double sum = 0.0;
+    for(const auto& ff:ws.swarm) {
+        double d2 = 0.0;
+        for(size_t k=0;k<c.size();++k) d2+=(ff.position[k]-c[k])*(ff.position[k]-c[k]);
+        sum += std::sqrt(d2);
+    }
+    return sum/ws.swarm.size()/(params.upper_bound-params.lower_bound);
+}
+
+// Fin de iteración: progreso y paradas anticipadas
+static void report(Engine& engine, FireflyWorkspace& ws, const FireflyParams& params) {
+    if(engine.needs_diversity()) engine.report_progress(swarm_diversity(ws, params));
+    else engine.report_progress();
+}
+
+// Suma en move la atracción de las luciérnagas más brillantes que fi
+static void attraction_move(const Firefly& fi, const ArenaVector<Firefly>& swarm,
+                            const FireflyParams& params, double* move) {
+    int dim = fi.position.size();
+    std::fill(move, move+dim, 0.0);
+    for(auto& fj:swarm) if(fj.fitness<fi.fitness) {
+        double r2=0;
+        for(int k=0;k<dim;++k) r2+=std::pow(fi.position[k]-fj.position[k],2);
+        double beta=params.beta0*std::exp(-params.gamma*std::sqrt(r2));
+        for(int k=0;k<dim;++k) move[k]+=beta*(fj.position[k]-fi.position[k]);
+    }
+}
+
+// Pasos aleatorios de las n primeras luciérnagas, uniformes en el rango
+static void random_steps(FireflyWorkspace& ws, int n, int dim, const FireflyParams& params, Rng& rng) {
+    auto& rnd = ws.rnd;
+    rng.fill_uniform(rnd.data(), (size_t)n*dim);
+    for(size_t k=0;k<(size_t)n*dim;++k)
+        rnd[k]=(rnd[k]-0.5)*(params.upper_bound-params.lower_bound);
+}
+
+// Generación secuencial (Gauss-Seidel) en el sitio: cada luciérnaga ve las
+// ya movidas. eval(i, posición) da el fitness de la i-ésima.
+template <class Eval>
+static void sequential_generation(FireflyWorkspace& ws, int n, int dim,
+                                  const FireflyParams& params, double alpha_t, Eval&& eval) {
+    auto& swarm = ws.swarm;
+    const auto& rnd = ws.rnd;
+    for(int i=0;i<n;++i) {
+        Firefly& fi = swarm[i];
+        double* move = &ws.moves[(size_t)i*dim];
+        attraction_move(fi, swarm, params, move);
+        for(int k=0;k<dim;++k)
+            fi.position[k]=clamp_val(fi.position[k]+move[k]+alpha_t*rnd[(size_t)i*dim+k],
+                                     params.lower_bound, params.upper_bound);
+        fi.fitness = eval(i, fi.position.data());
+    }
+}
+
+// Generación síncrona (Jacobi): los movimientos se calculan sobre una copia
+// congelada del enjambre y se aplican y evalúan en paralelo. Las evaluaciones
+// se contabilizan después en orden, así el contador de FEs y los milestones
+// son los mismos que con una evaluación secuencial.
+static void synchronous_generation(FireflyWorkspace& ws, int n, int dim,
+                                   const FireflyParams& params, double alpha_t,
+                                   Engine& engine) {
+    auto& swarm = ws.swarm;
+    auto& snapshot = ws.shadow;
+    for(size_t i=0;i<swarm.size();++i) snapshot[i] = swarm[i];
+    const auto& rnd = ws.rnd;
+
+    engine.pool()->parallel_for_static(n, [&](int i) {
+        PHASE_SCOPE(Phase::ATTRACTION);
+        double* move = &ws.moves[(size_t)i*dim];
+        attraction_move(snapshot[i], snapshot, params, move);
+        Firefly& fi = swarm[i];
+        for(int k=0;k<dim;++k)
+            fi.position[k]=clamp_val(snapshot[i].position[k]+move[k]+alpha_t*rnd[(size_t)i*dim+k],
+                                     params.lower_bound, params.upper_bound);
+        fi.fitness = engine.evaluate_uncounted(fi.position.data());
+    });
+    for(int i=0;i<n;++i) engine.commit(swarm[i].fitness, swarm[i].position.data());
+}
+
+// Contadores de la ejecución especulativa
+struct SpeculationStats {
+    long long commits = 0;   // luciérnagas confirmadas
+    long long hits = 0;      // confirmadas con el cálculo especulativo inicial
+    long long reexecs = 0;   // recálculos por especulación fallida
+};
+
+// Generación especulativa con la semántica de la secuencial (Gauss-Seidel).
+// Todas las luciérnagas se mueven y evalúan en paralelo sobre el estado
+// actual del enjambre y se confirman en orden. La luciérnaga k calculada con
+// el prefijo [0,base) ya confirmado solo es válida si ninguna j en [base,k)
+// era ni es más brillante que k: entonces no participaba en su atracción ni
+// antes ni después de moverse, y el movimiento coincide bit a bit con el
+// secuencial. Las inválidas se recalculan en paralelo desde el nuevo prefijo.
+static void speculative_generation(FireflyWorkspace& ws, int n, int dim,
+                                   const FireflyParams& params, double alpha_t,
+                                   Engine& engine, SpeculationStats& stats) {
+    ThreadPool& pool = *engine.pool();
+    auto& swarm = ws.swarm;
+    auto& spec = ws.shadow;
+    auto& old_fit = ws.old_fit;
+    auto& base = ws.base;
+    auto& reexecuted = ws.reexecuted;
+    auto& todo = ws.todo;
+    const auto& rnd = ws.rnd;
+    todo.resize(n);
+    for(int k=0;k<n;++k) {
+        old_fit[k]=swarm[k].fitness;
+        base[k]=0;
+        reexecuted[k]=0;
+        todo[k]=k;
+    }
+
+    // ¿Sigue siendo válida la especulación de k tras confirmar [0,p)?
+    auto valid = [&](int k, int p) {
+        double fk = swarm[k].fitness;
+        for(int j=base[k]; j<std::min(k,p); ++j)
+            if(old_fit[j]<fk || swarm[j].fitness<fk) return false;
+        return true;
+    };
+
+    int p = 0;
+    while(true) {
+        pool.parallel_for((int)todo.size(), [&](int t) {
+            PHASE_SCOPE(Phase::ATTRACTION);
+            int k = todo[t];
+            double* move = &ws.moves[(size_t)k*dim];
+            attraction_move(swarm[k], swarm, params, move);
+            for(int d=0;d<dim;++d)
+                spec[k].position[d]=clamp_val(swarm[k].position[d]+move[d]+alpha_t*rnd[(size_t)k*dim+d],
+                                              params.lower_bound, params.upper_bound);
+            spec[k].fitness = engine.evaluate_uncounted(spec[k].position.data());
+        });
+
+        // Confirmación en orden
+        for(; p<n && valid(p, p); ++p) {
+            std::swap(swarm[p].position, spec[p].position);
+            swarm[p].fitness = spec[p].fitness;
+            engine.commit(swarm[p].fitness, swarm[p].position.data());
+            ++stats.commits;
+            if(!reexecuted[p]) ++stats.hits;
+        }
+        if(p==n) break;
+
+        // Se recalculan p y las siguientes que ya se sabe que son inválidas,
+        // como mucho una por hilo: las más lejanas volverían a invalidarse
+        todo.clear();
+        for(int k=p;k<n && (int)todo.size()<pool.size();++k) if(!valid(k, p)) {
+            base[k]=p;
+            reexecuted[k]=1;
+            todo.push_back(k);
+        }
+        stats.reexecs += todo.size();
+    }
+}
+
+FireflyOptimizer::FireflyOptimizer(const FireflyParams& params, FireflyStats* stats)
+    : params_(params), stats_(stats) {}
+
+// Todos los parámetros menos los hilos, que no cambian el resultado;
+// SPECULATIVE da el mismo que SEQUENTIAL
+std::uint64_t FireflyOptimizer::state_key() const {
+    const FireflyParams& params = params_;
+    FireflyUpdate update = params.update==FireflyUpdate::SPECULATIVE ? FireflyUpdate::SEQUENTIAL
+                                                                     : params.update;
+    ResultKey key;
+    key.add(VERSION).add(params.num_fireflies).add(params.alpha).add(params.beta0).add(params.gamma)
+       .add(params.lower_bound).add(params.upper_bound).add(params.max_fes).add(params.T)
+       .add(params.mode).add(update).add(params.archive_size).add(params.local_search)
+       .add(params.ls_batch_pair).add(params.seed).add(params.islands).add(params.topology)
+       .add(params.migration_interval).add(params.migrants);
+    return key.value();
+}
+
 // Main Firefly run
-double run_firefly_algorithm(int dim, int func_id,
-                             const FireflyParams& params,
-                             const std::string& alg_name) {
-    cec17_init(alg_name.c_str(), func_id, dim);
-
-    std::vector<Firefly> swarm(params.num_fireflies);
-    for (auto& ff:swarm) initialize_firefly(ff, dim, params.lower_bound, params.upper_bound);
-
-    current_fes_counter = 0;
-    for (auto& ff:swarm) evaluate_firefly(ff);
-    Firefly best = *std::min_element(swarm.begin(), swarm.end(),
-                        [](auto&a,auto&b){return a.fitness<b.fitness;});
-    long long last_imp = current_fes_counter;
-    std::vector<Firefly> archive;
-    long long print_step = std::max(1LL, params.max_fes/10);
-    long long ls_budget = params.max_fes*0.2;
+void FireflyOptimizer::optimize(Engine& engine) {
+    if(params_.islands>1) {
+        optimize_islands(engine);
+        return;
+    }
+    if(params_.update==FireflyUpdate::ASYNC) {
+        optimize_async(engine);
+        return;
+    }
+    const FireflyParams& params = params_;
+    const int dim = engine.dim();
+    Rng& rng = engine.rng();
+    ThreadPool* pool = engine.pool();
+    std::ostream& out = engine.log(LogLevel::INFO);
+    if(params.update!=FireflyUpdate::SEQUENTIAL) {
+        out<<(params.update==FireflyUpdate::SYNCHRONOUS ? "Actualización síncrona"
+                                                              : "Actualización especulativa")
+                 <<" con "<<pool->size()<<" hilos\n";
+    }
+
+    Arena& arena = engine.arena();
+    FireflyWorkspace ws(params.num_fireflies, dim, params.archive_size, arena);
+    auto& swarm = ws.swarm;
+    auto& best = ws.best;
+    // La mejor y la peor se buscan por índice, las dos en un mismo recorrido
+    // O(N) tras cada generación: en una generación se mueven todas, así que
+    // no se pueden llevar al día sin recorrer el enjambre
+    size_t brightest = 0, worst = 0;
+    auto locate_extremes = [&]() {
+        brightest = worst = 0;
+        for(size_t i=1;i<swarm.size();++i) {
+            if(swarm[i].fitness<swarm[brightest].fitness) brightest = i;
+            if(swarm[i].fitness>swarm[worst].fitness) worst = i;
+        }
+    };
     int generation = 0;
 
-    std::cout<<"Inicial -> best: "<<std::scientific<<best.fitness
-             <<" (FEs: "<<current_fes_counter<<")\n";
-
-    while(current_fes_counter<params.max_fes) {
-        for(auto& fi:swarm) {
-            if(current_fes_counter>=params.max_fes) break;
-            std::vector<double> move(dim);
-            for(auto& fj:swarm) if(fj.fitness<fi.fitness) {
-                double r2=0;
-                for(int k=0;k<dim;++k) r2+=std::pow(fi.position[k]-fj.position[k],2);
-                double beta=params.beta0*std::exp(-params.gamma*std::sqrt(r2));
-                for(int k=0;k<dim;++k) move[k]+=beta*(fj.position[k]-fi.position[k]);
-            }
-            double alpha_t=params.alpha*std::pow(0.97,generation);
-            for(int k=0;k<dim;++k) {
-                double rnd=(dis(gen)-0.5)*(params.upper_bound-params.lower_bound);
-                fi.position[k]=clamp_val(fi.position[k]+move[k]+alpha_t*rnd,
-                                         params.lower_bound, params.upper_bound);
-            }
-            evaluate_firefly(fi);
-        }
-        auto curr_best=*std::min_element(swarm.begin(), swarm.end(),
-                             [](auto&a,auto&b){return a.fitness<b.fitness;});
-        if(curr_best.fitness<best.fitness) {
-            best=curr_best;
-            last_imp=current_fes_counter;
-            std::cout<<"Mejora global: "<<best.fitness
-                     <<" en FEs="<<current_fes_counter<<"\n";
-        }
-        // Memetic hibridación
-        if(params.mode==FireflyMode::LOCAL_SEARCH) {
-            if((generation%5==0 && ls_budget>0) || (current_fes_counter-last_imp>print_step)) {
-                memetic_local_search(best, params);
-                ls_budget -= (current_fes_counter-last_imp);
+    // Empieza con un 20% del presupuesto para la búsqueda local
+    LsScheduler scheduler(0.2, (long long)params.T*dim);
+    SpeculationStats spec_stats;
+
+    // Estado del algoritmo en los checkpoints, tras el del motor
+    auto save_state = [&](CheckpointWriter& w) {
+        w.put(params.num_fireflies);
+        w.put(generation);
+        for(const auto& ff:swarm) {
+            w.put_array(ff.position.data(), dim);
+            w.put(ff.fitness);
+        }
+        w.put_array(best.position.data(), dim);
+        w.put(best.fitness);
+        ws.archive.save(w);
+        scheduler.save(w);
+        w.put(spec_stats);
+    };
+    // El motor solo reanuda un checkpoint íntegro y de estos parámetros
+    // (state_key), así que el estado tiene el tamaño esperado
+    if(CheckpointReader* r = engine.resume()) {
+        r->get<int>();   // num_fireflies
+        generation = r->get<int>();
+        for(auto& ff:swarm) {
+            r->get_array(ff.position.data(), dim);
+            ff.fitness = r->get<double>();
+        }
+        r->get_array(best.position.data(), dim);
+        best.fitness = r->get<double>();
+        ws.archive.restore(*r);
+        scheduler.restore(*r);
+        spec_stats = r->get<SpeculationStats>();
+        locate_extremes();
+    } else {
+        PHASE_SCOPE(Phase::INIT);
+        for (auto& ff:swarm) initialize_firefly(ff, dim, params.lower_bound, params.upper_bound, rng);
+        for (auto& ff:swarm) evaluate_firefly(ff, engine);
+        locate_extremes();
+        best = swarm[brightest];
+        scheduler.swarm_step(engine.fes(), 0.0);
+    }
+
+    const int first_generation = generation;
+    long long steady_allocs = 0;  // reservas tras la primera generación
+
+    LsEvaluator ls_eval = engine.ls_evaluator();
+    SolisWetsParams sw_params;
+    sw_params.delta = (params.upper_bound - params.lower_bound) * 0.1;
+    sw_params.lower = params.lower_bound;
+    sw_params.upper = params.upper_bound;
+    sw_params.batch_pair = params.ls_batch_pair;
+    SolisWetsBuffers sw_buf{ws.sw_bias.data(), ws.sw_dif.data(), ws.sw_newsol.data()};
+
+    if(generation==0) {
+        out<<"Inicial -> best: "<<std::scientific<<best.fitness
+                 <<" (FEs: "<<engine.fes()<<")\n";
+        engine.snapshot(0, (int)swarm.size(), [&](int i) { return swarm[i].position.data(); },
+                        [&](int i) { return swarm[i].fitness; });
+    }
+    engine.report_progress();
+
+    while(!engine.exhausted()) {
+        long long gen_fes = engine.fes();
+        double gen_best = best.fitness;
+        double alpha_t=params.alpha*std::pow(0.97,generation);
+        // Solo se mueven las luciérnagas que caben en el presupuesto
+        int n = (int)std::min<long long>(swarm.size(), engine.remaining());
+        {
+            PHASE_SCOPE(Phase::ATTRACTION);
+            random_steps(ws, n, dim, params, rng);
+            if(params.update==FireflyUpdate::SYNCHRONOUS)
+                synchronous_generation(ws, n, dim, params, alpha_t, engine);
+            else if(params.update==FireflyUpdate::SPECULATIVE)
+                speculative_generation(ws, n, dim, params, alpha_t, engine, spec_stats);
+            else
+                sequential_generation(ws, n, dim, params, alpha_t,
+                                      [&](int, const double* x) { return engine.evaluate(x); });
+        }
+        locate_extremes();
+        const Firefly& curr_best = swarm[brightest];
+        if(curr_best.fitness<best.fitness) best=curr_best;
+        scheduler.swarm_step(engine.fes()-gen_fes, gen_best-best.fitness);
+        // Memetic hibridación: cuota fija por llamada, frecuencia según el rendimiento
+        if(params.mode==FireflyMode::LOCAL_SEARCH && !engine.exhausted()
+           && scheduler.due(engine.fes())) {
+            PHASE_SCOPE(Phase::LOCAL_SEARCH);
+            long long quota = scheduler.quota(engine.remaining());
+            double ls_start = best.fitness;
+            long long used;
+            if(params.local_search==LocalSearch::SOLIS_WETS) {
+                used = soliswets(best.position.data(), best.fitness, dim, quota,
+                                 sw_params, rng, sw_buf, ls_eval).evals;
+            } else {
+                used = memetic_local_search(best, params, rng, ws.ls_delta, ws.ls_probe, quota, ls_eval);
             }
+            scheduler.ls_step(used, ls_start-best.fitness);
         }
         // Elitismo
         if(params.mode==FireflyMode::ELITISTA) {
-            elitist_archive(swarm, archive, 5);
+            PHASE_SCOPE(Phase::ARCHIVE);
+            elitist_archive(swarm, ws.archive, worst, rng);
         }
-        if(current_fes_counter%print_step==0) {
-            std::cout<<"FEs "<<current_fes_counter
-                     <<", best: "<<std::scientific<<best.fitness<<"\n";
+        report(engine, ws, params);
+        if(generation==first_generation) steady_allocs = -alloc_count();
+        ++generation;
+        engine.snapshot(generation, (int)swarm.size(),
+                        [&](int i) { return swarm[i].position.data(); },
+                        [&](int i) { return swarm[i].fitness; });
+        // Las reservas del checkpoint (buffer, fichero) no cuentan
+        if(engine.checkpoint_due()) {
+            long long before = alloc_count();
+            engine.checkpoint(save_state);
+            steady_allocs -= alloc_count()-before;
+        }
+    }
+    steady_allocs += alloc_count();
+    out<<"Memoria de la ejecución (arena): "<<arena.used()/1024<<" KiB\n";
+    if(alloc_count()>=0)
+        out<<"Reservas de memoria tras la 1ª generación: "<<steady_allocs<<"\n";
+    if(params.update==FireflyUpdate::SPECULATIVE && spec_stats.commits>0) {
+        out<<"Especulación: "<<std::defaultfloat
+                 <<100.0*spec_stats.hits/spec_stats.commits<<"% aciertos ("
+                 <<spec_stats.hits<<"/"<<spec_stats.commits<<"), "
+                 <<spec_stats.reexecs<<" reejecuciones\n";
+    }
+    if(params.mode==FireflyMode::LOCAL_SEARCH) {
+        out<<"Búsqueda local: "<<scheduler.ls_calls()<<" llamadas, FEs enjambre/LS "
+                 <<scheduler.swarm_fes()<<"/"<<scheduler.ls_fes()
+                 <<", fracción final LS "<<std::defaultfloat<<scheduler.share()<<"\n";
+    }
+    if(stats_) {
+        stats_->fes = engine.fes();
+        stats_->swarm_fes = scheduler.swarm_fes();
+        stats_->ls_fes = scheduler.ls_fes();
+        stats_->ls_calls = scheduler.ls_calls();
+        stats_->swarm_gain = scheduler.swarm_gain();
+        stats_->ls_gain = scheduler.ls_gain();
+        stats_->ls_share = scheduler.share();
+        stats_->spec_commits = spec_stats.commits;
+        stats_->spec_hits = spec_stats.hits;
+        stats_->spec_reexecs = spec_stats.reexecs;
+    }
+}
+
+// Presupuesto de evaluaciones compartido por las islas. Cada evaluación
+// toma un ticket con un fetch_add atómico y publica su fitness en un anillo;
+// el hilo del motor las contabiliza en orden de ticket, así el contador de
+// FEs y los milestones son los de una ejecución secuencial en ese orden.
+class FeTickets {
+public:
+    FeTickets(long long max_fes, Arena& arena)
+        : max_fes_(max_fes), fit_(RING, ArenaAllocator<double>(&arena)),
+          seq_(new std::atomic<long long>[RING]()) {}
+
+    // Reserva hasta n tickets consecutivos desde first; devuelve cuántos
+    // (0 si el presupuesto se ha agotado)
+    int claim(int n, long long& first) {
+        if(closed_.load(std::memory_order_relaxed)) return 0;
+        long long start = next_.fetch_add(n, std::memory_order_relaxed);
+        if(start>=max_fes_) return 0;
+        first = start;
+        return (int)std::min<long long>(n, max_fes_-start);
+    }
+
+    // Un ticket solo espera si va RING por delante del último contabilizado;
+    // el menor pendiente nunca espera, así que no hay bloqueo mutuo
+    void publish(long long ticket, double fitness) {
+        while(ticket-committed_.load(std::memory_order_acquire)>=RING) {
+            if(closed_.load(std::memory_order_relaxed)) return;
+            std::this_thread::yield();
+        }
+        size_t slot = (size_t)(ticket & (RING-1));
+        fit_[slot] = fitness;
+        seq_[slot].store(ticket+1, std::memory_order_release);
+    }
+
+    // Hilo del motor: contabiliza los publicados en orden; devuelve cuántos
+    long long drain(Engine& engine) {
+        long long c = committed_.load(std::memory_order_relaxed), start = c;
+        while(c<max_fes_ && seq_[c & (RING-1)].load(std::memory_order_acquire)==c+1) {
+            engine.commit(fit_[(size_t)(c & (RING-1))]);
+            if((++c & 255)==0) committed_.store(c, std::memory_order_release);
+        }
+        committed_.store(c, std::memory_order_release);
+        return c-start;
+    }
+
+    // Parada anticipada: no se dan más tickets y lo pendiente se descarta
+    void close() { closed_.store(true, std::memory_order_relaxed); }
+
+private:
+    static constexpr long long RING = 1 << 14;
+
+    long long max_fes_;
+    std::atomic<long long> next_{0};
+    std::atomic<long long> committed_{0};
+    std::atomic<bool> closed_{false};
+    ArenaVector<double> fit_;
+    std::unique_ptr<std::atomic<long long>[]> seq_;   // ticket+1 publicado en cada hueco
+};
+
+// Evaluador de la búsqueda local dentro de una isla: un ticket por
+// evaluación; sin presupuesto devuelve +inf, que nunca se acepta
+struct IslandEvalContext {
+    Engine* engine;
+    FeTickets* tickets;
+    long long fes = 0;
+};
+
+static double island_ls_evaluate(void* ctx, double* sol) {
+    auto* c = static_cast<IslandEvalContext*>(ctx);
+    long long ticket;
+    if(!c->tickets->claim(1, ticket)) return std::numeric_limits<double>::infinity();
+    double fit = c->engine->evaluate_uncounted(sol);
+    c->tickets->publish(ticket, fit);
+    ++c->fes;
+    return fit;
+}
+
+// Una isla: subenjambre con su arena, su generador y sus colas
+static void run_island(int id, Engine& engine, const FireflyParams& params, FeTickets& tickets,
+                       MigrantQueue* const* out, int num_out, MigrantQueue* const* in, int num_in,
+                       IslandStats& stats) {
+    const int dim = engine.dim();
+    const int n = params.num_fireflies;
+    PhaseThread phases(engine.phases());
+    Arena arena;
+    Rng rng = engine.rng().split(id+1);
+    FireflyWorkspace ws(n, dim, params.archive_size, arena);
+    Position migrant(dim, ArenaAllocator<double>(&arena));
+    auto& swarm = ws.swarm;
+    auto& best = ws.best;
+    auto& order = ws.todo;   // índices por fitness para elegir emigrantes
+
+    IslandEvalContext ctx{&engine, &tickets};
+    LsEvaluator ls_eval{island_ls_evaluate, nullptr, &ctx};
+    auto evaluate_block = [&](long long first) {
+        return [&tickets, &engine, first](int i, const double* x) {
+            double fit = engine.evaluate_uncounted(x);
+            tickets.publish(first+i, fit);
+            return fit;
+        };
+    };
+
+    long long first;
+    int got;
+    {
+        PHASE_SCOPE(Phase::INIT);
+        for(auto& ff:swarm) initialize_firefly(ff, dim, params.lower_bound, params.upper_bound, rng);
+        got = tickets.claim(n, first);
+        auto eval_init = evaluate_block(first);
+        for(int i=0;i<got;++i) swarm[i].fitness = eval_init(i, swarm[i].position.data());
+        ctx.fes += got;
+    }
+
+    size_t brightest = 0, worst = 0;
+    auto locate_extremes = [&]() {
+        brightest = worst = 0;
+        for(size_t i=1;i<swarm.size();++i) {
+            if(swarm[i].fitness<swarm[brightest].fitness) brightest = i;
+            if(swarm[i].fitness>swarm[worst].fitness) worst = i;
+        }
+    };
+    locate_extremes();
+    best = swarm[brightest];
+
+    LsScheduler scheduler(0.2, (long long)params.T*dim);
+    scheduler.swarm_step(ctx.fes, 0.0);
+    SolisWetsParams sw_params;
+    sw_params.delta = (params.upper_bound - params.lower_bound) * 0.1;
+    sw_params.lower = params.lower_bound;
+    sw_params.upper = params.upper_bound;
+    SolisWetsBuffers sw_buf{ws.sw_bias.data(), ws.sw_dif.data(), ws.sw_newsol.data()};
+
+    int generation = 0;
+    while(got==n && (got = tickets.claim(n, first))>0) {
+        long long gen_fes = ctx.fes;
+        double gen_best = best.fitness;
+        double alpha_t=params.alpha*std::pow(0.97,generation);
+        {
+            PHASE_SCOPE(Phase::ATTRACTION);
+            random_steps(ws, got, dim, params, rng);
+            sequential_generation(ws, got, dim, params, alpha_t, evaluate_block(first));
+        }
+        ctx.fes += got;
+        locate_extremes();
+        if(swarm[brightest].fitness<best.fitness) best=swarm[brightest];
+        scheduler.swarm_step(ctx.fes-gen_fes, gen_best-best.fitness);
+
+        if(params.mode==FireflyMode::LOCAL_SEARCH && scheduler.due(ctx.fes)) {
+            PHASE_SCOPE(Phase::LOCAL_SEARCH);
+            double ls_start = best.fitness;
+            long long ls_fes = ctx.fes;
+            long long quota = scheduler.quota(std::numeric_limits<long long>::max());
+            if(params.local_search==LocalSearch::SOLIS_WETS)
+                soliswets(best.position.data(), best.fitness, dim, quota, sw_params, rng, sw_buf, ls_eval);
+            else
+                memetic_local_search(best, params, rng, ws.ls_delta, ws.ls_probe, quota, ls_eval);
+            scheduler.ls_step(ctx.fes-ls_fes, ls_start-best.fitness);
+        }
+        if(params.mode==FireflyMode::ELITISTA) {
+            PHASE_SCOPE(Phase::ARCHIVE);
+            elitist_archive(swarm, ws.archive, worst, rng);
         }
         ++generation;
+
+        // Migración: las mejores a cada vecina; cada inmigrante sustituye a
+        // la peor si la mejora
+        if(generation%params.migration_interval==0) {
+            int m = std::min(params.migrants, n);
+            for(int i=0;i<n;++i) order[i]=i;
+            std::partial_sort(order.begin(), order.begin()+m, order.end(),
+                              [&](int a, int b) { return swarm[a].fitness<swarm[b].fitness; });
+            for(int q=0;q<num_out;++q)
+                for(int k=0;k<m;++k)
+                    if(out[q]->push(swarm[order[k]].position.data(), swarm[order[k]].fitness)) ++stats.sent;
+            for(int q=0;q<num_in;++q) {
+                double fit;
+                while(in[q]->pop(migrant.data(), fit)) {
+                    ++stats.received;
+                    if(fit<swarm[worst].fitness) {
+                        std::swap(swarm[worst].position, migrant);
+                        swarm[worst].fitness = fit;
+                        ++stats.accepted;
+                        locate_extremes();
+                    }
+                }
+            }
+        }
+    }
+    stats.fes = ctx.fes;
+    stats.ls_fes = scheduler.ls_fes();
+    stats.generations = generation;
+    stats.best = best.fitness;
+    stats.best_position.assign(best.position.begin(), best.position.end());
+}
+
+// Modelo de islas: cada isla avanza en su hilo con sus propias evaluaciones
+// y este hilo (el del motor) las contabiliza en orden de ticket
+void FireflyOptimizer::optimize_islands(Engine& engine) {
+    const FireflyParams& params = params_;
+    const int k = params.islands;
+    const int dim = engine.dim();
+    std::ostream& out = engine.log(LogLevel::INFO);
+    out<<"Modelo de islas: "<<k<<" islas de "<<params.num_fireflies<<" luciérnagas, topología "
+       <<(params.topology==IslandTopology::RING ? "anillo" : "completa")
+       <<", migración cada "<<params.migration_interval<<" generaciones\n";
+
+    // Una cola por arista dirigida de la topología
+    Arena& arena = engine.arena();
+    FeTickets tickets(engine.max_fes(), arena);
+    std::vector<std::unique_ptr<MigrantQueue>> queues;
+    std::vector<std::vector<MigrantQueue*>> outgoing(k), incoming(k);
+    for(int i=0;i<k;++i)
+        for(int j=0;j<k;++j) {
+            bool edge = params.topology==IslandTopology::RING ? j==(i+1)%k : j!=i;
+            if(!edge) continue;
+            queues.push_back(std::make_unique<MigrantQueue>(4*std::max(1, params.migrants), dim, arena));
+            outgoing[i].push_back(queues.back().get());
+            incoming[j].push_back(queues.back().get());
+        }
+
+    std::vector<IslandStats> island_stats(k);
+    std::vector<std::thread> threads;
+    threads.reserve(k);
+    for(int i=0;i<k;++i)
+        threads.emplace_back([&, i] {
+            run_island(i, engine, params, tickets, outgoing[i].data(), (int)outgoing[i].size(),
+                       incoming[i].data(), (int)incoming[i].size(), island_stats[i]);
+            cec17_thread_release();
+        });
+
+    engine.report_progress();
+    while(!engine.exhausted()) {
+        if(tickets.drain(engine)>0) engine.report_progress();
+        else std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    if(engine.stopped()) tickets.close();
+    for(auto& t:threads) t.join();
+    for(const auto& is:island_stats) engine.offer_best(is.best_position.data(), is.best);
+
+    for(int i=0;i<k;++i) {
+        const IslandStats& is = island_stats[i];
+        out<<"Isla "<<i<<": FEs "<<is.fes<<", generaciones "<<is.generations
+           <<", mejor "<<std::scientific<<is.best<<", emigrantes "<<is.sent
+           <<", inmigrantes "<<is.received<<" ("<<is.accepted<<" aceptados)\n";
+    }
+    if(stats_) {
+        stats_->fes = engine.fes();
+        for(const auto& is:island_stats) {
+            stats_->swarm_fes += is.fes-is.ls_fes;
+            stats_->ls_fes += is.ls_fes;
+        }
+        stats_->islands = island_stats;
+    }
+}
+
+// Modo asíncrono de estado estacionario. Este hilo produce candidatas: la
+// de la luciérnaga i se calcula con el enjambre actual en ws.shadow[i] y su
+// índice entra en la cola de trabajos; los evaluadores la evalúan y la
+// devuelven por la cola de resultados, y aquí se contabiliza y sustituye a
+// la luciérnaga en cuanto llega. Cada luciérnaga tiene como mucho una
+// candidata en vuelo, así que su buffer nunca se comparte. Cada N
+// resultados integrados cuenta como una generación (alpha, búsqueda local,
+// elitismo).
+void FireflyOptimizer::optimize_async(Engine& engine) {
+    using Clock = std::chrono::steady_clock;
+    const FireflyParams& params = params_;
+    const int dim = engine.dim();
+    const int n = params.num_fireflies;
+    Rng& rng = engine.rng();
+    std::ostream& out = engine.log(LogLevel::INFO);
+    int workers = params.num_threads>0 ? params.num_threads
+                                       : (int)std::max(1u, std::thread::hardware_concurrency());
+
+    Arena& arena = engine.arena();
+    FireflyWorkspace ws(n, dim, params.archive_size, arena);
+    auto& swarm = ws.swarm;
+    auto& cand = ws.shadow;
+    auto& best = ws.best;
+    auto& in_flight = ws.reexecuted;
+    {
+        PHASE_SCOPE(Phase::INIT);
+        for(auto& ff:swarm) initialize_firefly(ff, dim, params.lower_bound, params.upper_bound, rng);
+        for(auto& ff:swarm) evaluate_firefly(ff, engine);
+    }
+
+    size_t brightest = 0, worst = 0;
+    auto locate_extremes = [&]() {
+        brightest = worst = 0;
+        for(size_t i=1;i<swarm.size();++i) {
+            if(swarm[i].fitness<swarm[brightest].fitness) brightest = i;
+            if(swarm[i].fitness>swarm[worst].fitness) worst = i;
+        }
+    };
+    locate_extremes();
+    best = swarm[brightest];
+    out<<"Actualización asíncrona con "<<workers<<" evaluadores\n";
+    out<<"Inicial -> best: "<<std::scientific<<best.fitness
+       <<" (FEs: "<<engine.fes()<<")\n";
+    engine.snapshot(0, n, [&](int i) { return swarm[i].position.data(); },
+                    [&](int i) { return swarm[i].fitness; });
+    engine.report_progress();
+
+    // Trabajos: índice de luciérnaga (-1 para terminar). Resultados: como
+    // mucho N en vuelo, así que los evaluadores nunca esperan para entregar.
+    BoundedQueue<int> jobs(2*workers);
+    BoundedQueue<int> results(n);
+    std::vector<double> busy(workers, 0.0);
+    std::vector<std::thread> threads;
+    threads.reserve(workers);
+    for(int w=0;w<workers;++w)
+        threads.emplace_back([&, w] {
+            PhaseThread phases(engine.phases());
+            for(int i=jobs.pop(); i>=0; i=jobs.pop()) {
+                PHASE_SCOPE(Phase::ATTRACTION);
+                auto start = Clock::now();
+                cand[i].fitness = engine.evaluate_uncounted(cand[i].position.data());
+                busy[w] += std::chrono::duration<double>(Clock::now()-start).count();
+                results.push(i);
+            }
+            cec17_thread_release();
+        });
+    auto started = Clock::now();
+
+    LsScheduler scheduler(0.2, (long long)params.T*dim);
+    scheduler.swarm_step(engine.fes(), 0.0);
+    LsEvaluator ls_eval = engine.ls_evaluator();
+    SolisWetsParams sw_params;
+    sw_params.delta = (params.upper_bound - params.lower_bound) * 0.1;
+    sw_params.lower = params.lower_bound;
+    sw_params.upper = params.upper_bound;
+    SolisWetsBuffers sw_buf{ws.sw_bias.data(), ws.sw_dif.data(), ws.sw_newsol.data()};
+
+    std::fill(in_flight.begin(), in_flight.end(), 0);
+    int pending = 0, cursor = 0, generation = 0;
+    long long integrated = 0, gen_fes = engine.fes(), depth_sum = 0, depth_samples = 0;
+    int depth_max = 0;
+    double gen_best = best.fitness;
+    double alpha_t = params.alpha;
+    double* step = ws.rnd.data();
+
+    for(;;) {
+        // Se lanzan candidatas mientras quede presupuesto, luciérnagas libres
+        // y sitio en la cola
+        while(pending<engine.remaining() && pending<n
+              && jobs.size()<jobs.capacity()) {
+            PHASE_SCOPE(Phase::ATTRACTION);
+            while(in_flight[cursor]) cursor = (cursor+1)%n;
+            int i = cursor;
+            double* move = &ws.moves[(size_t)i*dim];
+            attraction_move(swarm[i], swarm, params, move);
+            rng.fill_uniform(step, dim);
+            for(int k=0;k<dim;++k)
+                cand[i].position[k]=clamp_val(swarm[i].position[k]+move[k]
+                                              +alpha_t*(step[k]-0.5)*(params.upper_bound-params.lower_bound),
+                                              params.lower_bound, params.upper_bound);
+            jobs.push(i);   // solo este hilo encola: hay sitio
+            in_flight[i] = 1;
+            ++pending;
+            cursor = (cursor+1)%n;
+            int depth = jobs.size();
+            depth_sum += depth;
+            ++depth_samples;
+            depth_max = std::max(depth_max, depth);
+        }
+        if(pending==0) break;
+
+        // Se integra el siguiente resultado en cuanto llega
+        int i = results.pop();
+        --pending;
+        in_flight[i] = 0;
+        engine.commit(cand[i].fitness, cand[i].position.data());
+        std::swap(swarm[i].position, cand[i].position);
+        swarm[i].fitness = cand[i].fitness;
+        if(swarm[i].fitness<best.fitness) best = swarm[i];
+
+        if(++integrated%n==0) {
+            locate_extremes();
+            scheduler.swarm_step(engine.fes()-gen_fes, gen_best-best.fitness);
+            if(params.mode==FireflyMode::LOCAL_SEARCH && !engine.exhausted()
+               && scheduler.due(engine.fes())) {
+                // Las candidatas en vuelo siguen evaluándose mientras tanto
+                PHASE_SCOPE(Phase::LOCAL_SEARCH);
+                long long quota = scheduler.quota(engine.remaining()-pending);
+                double ls_start = best.fitness;
+                long long used = 0;
+                if(quota>0) {
+                    if(params.local_search==LocalSearch::SOLIS_WETS)
+                        used = soliswets(best.position.data(), best.fitness, dim, quota,
+                                         sw_params, rng, sw_buf, ls_eval).evals;
+                    else
+                        used = memetic_local_search(best, params, rng, ws.ls_delta, ws.ls_probe,
+                                                    quota, ls_eval);
+                }
+                scheduler.ls_step(used, ls_start-best.fitness);
+            }
+            if(params.mode==FireflyMode::ELITISTA) {
+                // Las luciérnagas en vuelo se moverán igualmente: solo se
+                // reinyecta sobre la peor si está libre
+                PHASE_SCOPE(Phase::ARCHIVE);
+                if(!in_flight[worst]) elitist_archive(swarm, ws.archive, worst, rng);
+            }
+            report(engine, ws, params);
+            ++generation;
+            engine.snapshot(generation, n, [&](int j) { return swarm[j].position.data(); },
+                            [&](int j) { return swarm[j].fitness; });
+            alpha_t = params.alpha*std::pow(0.97, generation);
+            gen_fes = engine.fes();
+            gen_best = best.fitness;
+        }
+    }
+    for(int w=0;w<workers;++w) jobs.push(-1);
+    for(auto& t:threads) t.join();
+
+    double wall = std::chrono::duration<double>(Clock::now()-started).count();
+    double busy_total = 0.0;
+    for(double b:busy) busy_total += b;
+    double utilization = wall>0 ? busy_total/(wall*workers) : 0.0;
+    double mean_depth = depth_samples ? (double)depth_sum/depth_samples : 0.0;
+    out<<"Asíncrona: cola media "<<std::defaultfloat<<mean_depth<<" (máx "<<depth_max
+       <<" de "<<jobs.capacity()<<"), uso de los evaluadores "<<100.0*utilization<<"%\n";
+    if(params.mode==FireflyMode::LOCAL_SEARCH) {
+        out<<"Búsqueda local: "<<scheduler.ls_calls()<<" llamadas, FEs enjambre/LS "
+           <<scheduler.swarm_fes()<<"/"<<scheduler.ls_fes()
+           <<", fracción final LS "<<scheduler.share()<<"\n";
+    }
+    if(stats_) {
+        stats_->fes = engine.fes();
+        stats_->swarm_fes = engine.fes()-scheduler.ls_fes();
+        stats_->ls_fes = scheduler.ls_fes();
+        stats_->ls_calls = scheduler.ls_calls();
+        stats_->swarm_gain = scheduler.swarm_gain();
+        stats_->ls_gain = scheduler.ls_gain();
+        stats_->ls_share = scheduler.share();
+        stats_->async_queue_depth = mean_depth;
+        stats_->async_utilization = utilization;
     }
-    std::cout<<"Final best F"<<func_id<<" D"<<dim
-             <<": "<<std::scientific<<best.fitness
-             <<" (FEs: "<<current_fes_counter<<")\n";
-    std::cout<<"Error: "<<std::scientific<<cec17_error(best.fitness)<<"\n";
-    return best.fitness;
+}
+
+EngineConfig firefly_engine_config(int dim, int func_id, const FireflyParams& params,
+                                   const std::string& alg_name) {
+    EngineConfig config{dim, func_id, alg_name, params.max_fes};
+    config.lower_bound = params.lower_bound;
+    config.upper_bound = params.upper_bound;
+    config.seed = params.seed;
+    // ASYNC lanza sus propios evaluadores y no usa el pool del motor
+    bool pool = params.update==FireflyUpdate::SYNCHRONOUS || params.update==FireflyUpdate::SPECULATIVE;
+    config.num_threads = pool ? params.num_threads : 1;
+    config.snapshot_swarm = params.num_fireflies;
+    return config;
+}
+
+double run_firefly_algorithm(int dim, int func_id,
+                             const FireflyParams& params,
+                             const std::string& alg_name,
+                             FireflyStats* stats) {
+    Engine engine(firefly_engine_config(dim, func_id, params, alg_name));
+    FireflyOptimizer firefly(params, stats);
+    return engine.run(firefly);
 }
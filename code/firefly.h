@@ -4,6 +4,8 @@
 
 #include <vector>
 #include <string>
+#include "arena.h"
+#include "optimizer.h"
 
 #define NUM_FIREFLIES_DEFAULT 40
 #define ALPHA_DEFAULT         0.5
@@ -11,12 +13,41 @@
 #define GAMMA_DEFAULT         0.1
 #define LOWER_BOUND_DEFAULT  -100.0
 #define UPPER_BOUND_DEFAULT   100.0
+#define ARCHIVE_SIZE_DEFAULT  5
 
 // Tres modos de ejecución:
 enum class FireflyMode { BASIC, LOCAL_SEARCH, ELITISTA };
 
+// Esquema de actualización de cada generación:
+//  SEQUENTIAL  -> en el sitio (Gauss-Seidel), cada luciérnaga ve las ya movidas
+//  SYNCHRONOUS -> todas se mueven desde una copia congelada del enjambre
+//                 (Jacobi), en paralelo sobre num_threads hilos
+//  SPECULATIVE -> como SEQUENTIAL (mismo resultado bit a bit para una misma
+//                 semilla), pero calcula y evalúa en paralelo de forma
+//                 especulativa y solo repite las luciérnagas mal especuladas
+//  ASYNC       -> estado estacionario: se generan candidatas desde el
+//                 enjambre actual, num_threads hilos las evalúan desde una
+//                 cola acotada y cada resultado se integra en cuanto llega,
+//                 sin barrera por generación
+enum class FireflyUpdate { SEQUENTIAL, SYNCHRONOUS, SPECULATIVE, ASYNC };
+
+// Búsqueda local del modo LOCAL_SEARCH:
+//  COORDINATE -> búsqueda por coordenadas (memetic_local_search)
+//  SOLIS_WETS -> Solis-Wets (soliswets.h)
+// En los dos casos cada llamada tiene una cuota de T*D evaluaciones y
+// LsScheduler (ls_scheduler.h) decide cuándo se lanza.
+enum class LocalSearch { COORDINATE, SOLIS_WETS };
+
+// Topología de migración del modelo de islas:
+//  RING -> cada isla envía a la siguiente
+//  FULL -> cada isla envía a todas las demás
+enum class IslandTopology { RING, FULL };
+
+// Posición reservada en la arena de la ejecución (o en el heap sin arena)
+using Position = ArenaVector<double>;
+
 struct Firefly {
-    std::vector<double> position;
+    Position position;
     double fitness;
 };
 
@@ -30,12 +61,85 @@ struct FireflyParams {
     long long max_fes;
     int T;                // para local search
     FireflyMode mode;     // modo de ejecución
+    FireflyUpdate update = FireflyUpdate::SEQUENTIAL;
+    int archive_size = ARCHIVE_SIZE_DEFAULT;  // élites del modo ELITISTA
+    LocalSearch local_search = LocalSearch::COORDINATE;
+    bool ls_batch_pair = false;  // Solis-Wets: evaluar juntas las sondas + y -
+    int num_threads = 0;  // hilos para SYNCHRONOUS/SPECULATIVE/ASYNC (0 = todos los núcleos)
+    unsigned long long seed = 0;  // semilla del generador de la ejecución (0 = aleatoria)
+    // Modelo de islas: con islands > 1 hay islands subenjambres de
+    // num_fireflies luciérnagas, cada uno en su hilo y con actualización
+    // secuencial, que comparten el presupuesto de evaluaciones
+    int islands = 1;
+    IslandTopology topology = IslandTopology::RING;
+    int migration_interval = 10;  // generaciones entre migraciones
+    int migrants = 2;             // mejores luciérnagas que emigran cada vez
+};
+
+// Estadísticas de una isla del modelo de islas
+struct IslandStats {
+    long long fes = 0;
+    long long ls_fes = 0;     // de fes, las de la búsqueda local
+    int generations = 0;
+    double best = 0.0;
+    long long sent = 0;       // emigrantes enviados
+    long long received = 0;   // inmigrantes recibidos
+    long long accepted = 0;   // inmigrantes que sustituyeron a la peor
+    std::vector<double> best_position;
+};
+
+// Estadísticas de una ejecución: reparto de evaluaciones entre el enjambre
+// y la búsqueda local, mejora conseguida por cada fase y especulación
+struct FireflyStats {
+    long long fes = 0;
+    long long swarm_fes = 0;
+    long long ls_fes = 0;
+    int ls_calls = 0;
+    double swarm_gain = 0.0;   // reducción del mejor fitness en cada fase
+    double ls_gain = 0.0;
+    double ls_share = 0.0;     // fracción final reservada a la búsqueda local
+    long long spec_commits = 0;
+    long long spec_hits = 0;
+    long long spec_reexecs = 0;
+    std::vector<IslandStats> islands;   // vacío sin modelo de islas
+    double async_queue_depth = 0.0;     // ASYNC: profundidad media de la cola
+    double async_utilization = 0.0;     // ASYNC: fracción del tiempo evaluando
 };
 
-// Devuelve el mejor fitness encontrado
-// El modo se obtiene de params.mode
+// Algoritmo de luciérnagas sobre el motor común (engine.h). Usa el pool del
+// motor para SYNCHRONOUS/SPECULATIVE, así que el motor debe tener hilos
+// cuando params.update no es SEQUENTIAL. Si stats no es nulo se rellena al acabar.
+class FireflyOptimizer : public Optimizer {
+public:
+    explicit FireflyOptimizer(const FireflyParams& params, FireflyStats* stats = nullptr);
+
+    // Se incrementa cuando cambian los resultados de una misma semilla, para
+    // que la caché de resultados (result_cache.h) repita los trabajos
+    static constexpr int VERSION = 1;
+
+    const char* name() const override { return "firefly"; }
+    std::uint64_t state_key() const override;
+    void optimize(Engine& engine) override;
+
+private:
+    void optimize_islands(Engine& engine);
+    void optimize_async(Engine& engine);
+
+    FireflyParams params_;
+    FireflyStats* stats_;
+};
+
+// Configuración del motor para params: presupuesto, límites, semilla y
+// pool solo si la actualización es paralela
+struct EngineConfig;
+EngineConfig firefly_engine_config(int dim, int func_id, const FireflyParams& params,
+                                   const std::string& alg_name);
+
+// Ejecuta FireflyOptimizer en un motor configurado con params y devuelve
+// el mejor fitness encontrado. El modo se obtiene de params.mode.
 double run_firefly_algorithm(int dim, int func_id,
                              const FireflyParams& params,
-                             const std::string& alg_name);
+                             const std::string& alg_name,
+                             FireflyStats* stats = nullptr);
 
 #endif // FIREFLY_H
@@ -0,0 +1,172 @@
+// grid_scheduler.cpp
+#include "grid_scheduler.h"
+#include "cec17.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <string_view>
+#include <thread>
+
+// Tiempo relativo de una evaluación a D=10 (F1 = 1), medido con cec17_evaluate
+static const double FUNCTION_WEIGHT[31] = {
+    0.0,
+    1.0, 1.7, 0.7, 0.6, 1.7, 7.7, 2.3, 1.5, 1.5, 3.1,
+    1.3, 2.3, 1.8, 2.2, 1.1, 1.9, 7.2, 1.7, 41.0, 11.0,
+    6.5, 7.9, 7.7, 7.0, 6.3, 9.4, 10.0, 8.0, 11.0, 45.0
+};
+
+// Reserva inicial para la salida de cada trabajo; con debug crece
+static const std::size_t JOB_LOG_RESERVE = 64 * 1024;
+
+double grid_cost(int func_id, int dim, long long max_fes) {
+    double weight = (func_id >= 1 && func_id <= 30) ? FUNCTION_WEIGHT[func_id] : 1.0;
+    return static_cast<double>(max_fes) * dim * dim * weight;
+}
+
+namespace {
+
+// Salida de un trabajo sobre un buffer reservado de antemano, que es el
+// área de escritura del streambuf: el texto se copia sin pasar por
+// overflow. Si no cabe (debug escribe cada mejora), overflow lo dobla; esa
+// reserva es memoria del trabajo y alloc_counter.h la cuenta.
+class JobLog : public std::streambuf {
+public:
+    JobLog() : buffer_(JOB_LOG_RESERVE) { setp(buffer_.data(), buffer_.data() + buffer_.size()); }
+
+    std::string_view text() const { return {pbase(), static_cast<std::size_t>(pptr() - pbase())}; }
+
+protected:
+    int_type overflow(int_type c) override {
+        if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+        std::ptrdiff_t used = pptr() - pbase();
+        buffer_.resize(2 * buffer_.size());
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+        pbump(static_cast<int>(used));
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+        return c;
+    }
+
+private:
+    std::vector<char> buffer_;
+};
+
+struct WorkerQueue {
+    std::mutex mtx;
+    std::deque<int> jobs;   // de mayor a menor coste
+};
+
+} // namespace
+
+GridScheduler::GridScheduler(int num_workers, bool show_times)
+    : workers_(num_workers), show_times_(show_times) {
+    if (workers_ <= 0) {
+        workers_ = static_cast<int>(std::thread::hardware_concurrency());
+        if (workers_ <= 0) workers_ = 1;
+    }
+}
+
+void GridScheduler::run() {
+    timings_.clear();
+    if (jobs_.empty()) return;
+
+    // Mayor coste primero (LPT), repartido por turnos entre las colas
+    std::vector<int> order(jobs_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](int a, int b) { return jobs_[a].cost > jobs_[b].cost; });
+    const int num_workers = static_cast<int>(std::min<std::size_t>(workers_, jobs_.size()));
+    std::vector<WorkerQueue> queues(num_workers);
+    for (std::size_t i = 0; i < order.size(); ++i)
+        queues[i % num_workers].jobs.push_back(order[i]);
+
+    std::vector<double> seconds(jobs_.size(), -1.0);
+    std::mutex out_mtx;
+
+    // Primero la cola propia; si está vacía, el trabajo pendiente más caro
+    // de las demás. Como las colas solo se vacían, -1 significa que no queda nada.
+    auto next_job = [&](int id) -> int {
+        {
+            std::lock_guard<std::mutex> lock(queues[id].mtx);
+            if (!queues[id].jobs.empty()) {
+                int j = queues[id].jobs.front();
+                queues[id].jobs.pop_front();
+                return j;
+            }
+        }
+        for (;;) {
+            int victim = -1;
+            double victim_cost = -1.0;
+            for (int v = 0; v < num_workers; ++v) {
+                if (v == id) continue;
+                std::lock_guard<std::mutex> lock(queues[v].mtx);
+                if (!queues[v].jobs.empty() && jobs_[queues[v].jobs.front()].cost > victim_cost) {
+                    victim = v;
+                    victim_cost = jobs_[queues[v].jobs.front()].cost;
+                }
+            }
+            if (victim < 0) return -1;
+            std::lock_guard<std::mutex> lock(queues[victim].mtx);
+            if (!queues[victim].jobs.empty()) {
+                int j = queues[victim].jobs.front();
+                queues[victim].jobs.pop_front();
+                return j;
+            }
+        }
+    };
+
+    auto worker = [&](int id) {
+        for (int j = next_job(id); j >= 0; j = next_job(id)) {
+            GridJob& job = jobs_[j];
+            auto start = std::chrono::steady_clock::now();
+            if (num_workers == 1) {
+                std::cout << job.header;
+                job.run(std::cout);
+            } else {
+                JobLog buffer;
+                std::ostream log(&buffer);
+                job.run(log);
+                std::lock_guard<std::mutex> lock(out_mtx);
+                std::cout << job.header << buffer.text();
+            }
+            seconds[j] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (!show_times_) continue;
+
+            char line[64];
+            std::snprintf(line, sizeof(line), "%.2f", seconds[j]);
+            std::lock_guard<std::mutex> lock(out_mtx);
+            std::cout << "⏱️ " << job.name << ": " << line << " s\n" << std::flush;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_workers - 1);
+    for (int t = 1; t < num_workers; ++t)
+        threads.emplace_back([&worker, t] {
+            worker(t);
+            cec17_thread_release();
+        });
+    worker(0);
+    for (auto& t : threads) t.join();
+
+    for (int j : order)
+        timings_.push_back({jobs_[j].name, jobs_[j].func_id, jobs_[j].dim, jobs_[j].cost, seconds[j]});
+}
+
+void GridScheduler::write_timings(const std::string& path) const {
+    if (timings_.empty()) return;
+    bool exists = std::ifstream(path).good();
+    std::ofstream out(path, std::ios::app);
+    if (!out) {
+        std::cerr << "Error: no se puede escribir " << path << "\n";
+        return;
+    }
+    if (!exists) out << "job,funcid,dim,cost,seconds\n";
+    for (const auto& t : timings_)
+        out << t.name << "," << t.func_id << "," << t.dim << "," << t.cost << "," << t.seconds << "\n";
+}
@@ -0,0 +1,63 @@
+// grid_scheduler.h
+#ifndef GRID_SCHEDULER_H
+#define GRID_SCHEDULER_H
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Un trabajo del barrido de experimentos (función x dimensión x algoritmo)
+struct GridJob {
+    std::string name;      // identificador para el fichero de tiempos
+    std::string header;    // cabecera que se muestra antes de su salida
+    int func_id;
+    int dim;
+    double cost;           // coste estimado (grid_cost)
+    std::function<void(std::ostream& log)> run;
+};
+
+// Coste estimado de un trabajo: max_fes x D^2 x peso de la función.
+// Los pesos son el tiempo relativo de una evaluación a D=10 (F1 = 1).
+double grid_cost(int func_id, int dim, long long max_fes);
+
+// Planificador del barrido. Los trabajos se ordenan de mayor a menor coste
+// y se reparten entre las colas de los hilos; un hilo sin trabajo roba a
+// otro el trabajo pendiente más caro. Cada hilo tiene su propio contexto
+// del evaluador CEC17 (el estado de cec17 es por hilo).
+//
+// Con un hilo la salida de cada trabajo va directa a std::cout; con más,
+// se guarda y se muestra entera al acabar el trabajo para que no se mezcle.
+class GridScheduler {
+public:
+    // num_workers <= 0 -> todos los núcleos disponibles; show_times: el
+    // tiempo de cada trabajo se muestra al terminarlo
+    explicit GridScheduler(int num_workers = 0, bool show_times = true);
+
+    void add(GridJob job) { jobs_.push_back(std::move(job)); }
+    std::size_t size() const { return jobs_.size(); }
+    int workers() const { return workers_; }
+
+    // Ejecuta todos los trabajos y espera a que terminen
+    void run();
+
+    // Añade a path (CSV) el tiempo real de cada trabajo ejecutado, para
+    // reajustar el modelo de coste
+    void write_timings(const std::string& path) const;
+
+private:
+    struct Timing {
+        std::string name;
+        int func_id;
+        int dim;
+        double cost;
+        double seconds;
+    };
+
+    int workers_;
+    bool show_times_;
+    std::vector<GridJob> jobs_;
+    std::vector<Timing> timings_;
+};
+
+#endif // GRID_SCHEDULER_H
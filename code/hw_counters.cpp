@@ -0,0 +1,91 @@
+// hw_counters.cpp
+#include "hw_counters.h"
+
+#ifdef __linux__
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+struct HwEventSpec {
+    std::uint32_t type;
+    std::uint64_t config;
+};
+
+static const HwEventSpec HW_EVENT_SPECS[HW_EVENTS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                         | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+static int open_event(const HwEventSpec& spec, int group) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.disabled = group < 0;   // el grupo entero se activa con el líder
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+HwCounters::HwCounters() {
+    for (int e = 0; e < HW_EVENTS; ++e) fd_[e] = slot_[e] = -1;
+    leader_ = open_event(HW_EVENT_SPECS[HW_CYCLES], -1);
+    if (leader_ < 0) {
+        error_ = std::strerror(errno);
+        int paranoid;
+        if (std::ifstream("/proc/sys/kernel/perf_event_paranoid") >> paranoid)
+            error_ += " (perf_event_paranoid=" + std::to_string(paranoid) + ")";
+        return;
+    }
+    fd_[HW_CYCLES] = leader_;
+    slot_[HW_CYCLES] = members_++;
+    for (int e = HW_CYCLES + 1; e < HW_EVENTS; ++e) {
+        fd_[e] = open_event(HW_EVENT_SPECS[e], leader_);
+        if (fd_[e] >= 0) slot_[e] = members_++;
+    }
+    ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+HwCounters::~HwCounters() {
+    for (int e = 0; e < HW_EVENTS; ++e)
+        if (fd_[e] >= 0) close(fd_[e]);
+}
+
+bool HwCounters::read(long long values[HW_EVENTS], long long* enabled, long long* running) {
+    if (leader_ < 0) return false;
+    // nr, tiempo activo, tiempo contando y un valor por miembro
+    std::uint64_t buf[3 + HW_EVENTS];
+    ssize_t bytes = ::read(leader_, buf, sizeof(buf));
+    if (bytes < (ssize_t)(3 * sizeof(std::uint64_t)) || (int)buf[0] != members_) return false;
+    if (buf[2] < buf[1]) multiplexed_ = true;
+    if (enabled) *enabled = (long long)buf[1];
+    if (running) *running = (long long)buf[2];
+    for (int e = 0; e < HW_EVENTS; ++e)
+        if (slot_[e] >= 0) values[e] = (long long)buf[3 + slot_[e]];
+    return true;
+}
+
+#else
+
+HwCounters::HwCounters() : error_("perf_event solo existe en Linux") {
+    for (int e = 0; e < HW_EVENTS; ++e) fd_[e] = slot_[e] = -1;
+}
+
+HwCounters::~HwCounters() {}
+
+bool HwCounters::read(long long*, long long*, long long*) { return false; }
+
+#endif
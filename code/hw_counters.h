@@ -0,0 +1,53 @@
+// hw_counters.h
+#ifndef HW_COUNTERS_H
+#define HW_COUNTERS_H
+
+#include <string>
+
+// Contadores hardware de un grupo de perf_event
+enum HwEvent {
+    HW_CYCLES,
+    HW_INSTRUCTIONS,
+    HW_L1D_MISSES,      // fallos de lectura en L1 de datos
+    HW_LLC_MISSES,      // fallos en el último nivel de caché
+    HW_BRANCH_MISSES,   // saltos mal predichos
+    HW_EVENTS
+};
+
+// Grupo de contadores hardware del hilo que lo crea (perf_event_open,
+// solo Linux), en modo usuario. Los ciclos son el líder: si no se pueden
+// abrir (contenedores, perf_event_paranoid alto, máquinas virtuales sin
+// PMU) ok() es false y error() dice por qué; cualquier otro evento que
+// falte solo deja de contarse (has).
+class HwCounters {
+public:
+    HwCounters();
+    ~HwCounters();
+
+    HwCounters(const HwCounters&) = delete;
+    HwCounters& operator=(const HwCounters&) = delete;
+
+    bool ok() const { return leader_ >= 0; }
+    bool has(int event) const { return slot_[event] >= 0; }
+    const std::string& error() const { return error_; }
+
+    // Cuentas desde que se abrió el grupo (una llamada al sistema); los
+    // eventos que faltan se quedan como estaban. Con enabled y running
+    // devuelve además los ns que el grupo lleva activo y contando: si ha
+    // compartido la PMU con otros grupos, running < enabled y las cuentas
+    // son solo del tiempo en que contaba
+    bool read(long long values[HW_EVENTS], long long* enabled = nullptr, long long* running = nullptr);
+
+    // ¿Ha compartido la PMU con otros grupos en alguna lectura?
+    bool multiplexed() const { return multiplexed_; }
+
+private:
+    int fd_[HW_EVENTS];
+    int slot_[HW_EVENTS];   // posición en la lectura del grupo, -1 si falta
+    int members_ = 0;
+    int leader_ = -1;
+    bool multiplexed_ = false;
+    std::string error_;
+};
+
+#endif // HW_COUNTERS_H
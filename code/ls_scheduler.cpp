@@ -0,0 +1,72 @@
+// ls_scheduler.cpp
+#include "ls_scheduler.h"
+#include <algorithm>
+
+// Límites de la fracción de búsqueda local y peso de la última medida
+static const double LS_SHARE_MIN = 0.02;
+static const double LS_SHARE_MAX = 0.8;
+static const double LS_RATE_WEIGHT = 0.3;
+
+LsScheduler::LsScheduler(double initial_share, long long quota)
+    : share_(initial_share), quota_(quota > 0 ? quota : 1) {}
+
+static void update_rate(double& rate, bool& seen, long long fes, double gain) {
+    double r = gain / fes;
+    rate = seen ? (1.0 - LS_RATE_WEIGHT) * rate + LS_RATE_WEIGHT * r : r;
+    seen = true;
+}
+
+void LsScheduler::swarm_step(long long fes, double gain) {
+    if (fes <= 0) return;
+    gain = std::max(gain, 0.0);
+    swarm_fes_ += fes;
+    swarm_gain_ += gain;
+    update_rate(swarm_rate_, swarm_seen_, fes, gain);
+    rebalance();
+}
+
+void LsScheduler::ls_step(long long fes, double gain) {
+    ++ls_calls_;
+    if (fes <= 0) return;
+    gain = std::max(gain, 0.0);
+    ls_fes_ += fes;
+    ls_gain_ += gain;
+    update_rate(ls_rate_, ls_seen_, fes, gain);
+    rebalance();
+}
+
+// La fracción se acerca a la parte de mejora por evaluación que aporta la
+// búsqueda local. Hasta medir las dos fases se mantiene la inicial.
+void LsScheduler::rebalance() {
+    if (!swarm_seen_ || !ls_seen_) return;
+    double total = swarm_rate_ + ls_rate_;
+    if (total <= 0.0) return;
+    double target = std::min(std::max(ls_rate_ / total, LS_SHARE_MIN), LS_SHARE_MAX);
+    share_ = 0.5 * share_ + 0.5 * target;
+}
+
+void LsScheduler::save(CheckpointWriter& out) const {
+    out.put(share_);
+    out.put(swarm_rate_);
+    out.put(ls_rate_);
+    out.put(swarm_seen_);
+    out.put(ls_seen_);
+    out.put(swarm_fes_);
+    out.put(ls_fes_);
+    out.put(swarm_gain_);
+    out.put(ls_gain_);
+    out.put(ls_calls_);
+}
+
+void LsScheduler::restore(CheckpointReader& in) {
+    share_ = in.get<double>();
+    swarm_rate_ = in.get<double>();
+    ls_rate_ = in.get<double>();
+    swarm_seen_ = in.get<bool>();
+    ls_seen_ = in.get<bool>();
+    swarm_fes_ = in.get<long long>();
+    ls_fes_ = in.get<long long>();
+    swarm_gain_ = in.get<double>();
+    ls_gain_ = in.get<double>();
+    ls_calls_ = in.get<int>();
+}
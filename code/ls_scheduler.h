@@ -0,0 +1,54 @@
+// ls_scheduler.h
+#ifndef LS_SCHEDULER_H
+#define LS_SCHEDULER_H
+
+#include "checkpoint.h"
+
+// Reparto adaptativo de evaluaciones entre el enjambre y la búsqueda local.
+// Mide la mejora por evaluación de cada fase (media exponencial) y mueve
+// la fracción del presupuesto reservada a la búsqueda local hacia la fase
+// que más rinde. La búsqueda local se lanza cuando lo gastado en ella va
+// por debajo de su fracción, siempre con una cuota fija de evaluaciones.
+class LsScheduler {
+public:
+    LsScheduler(double initial_share, long long quota);
+
+    // ¿Toca búsqueda local, con total_fes evaluaciones gastadas?
+    bool due(long long total_fes) const { return ls_fes_ < share_ * total_fes; }
+
+    // Evaluaciones para la próxima llamada, sin pasar de remaining
+    long long quota(long long remaining) const { return quota_ < remaining ? quota_ : remaining; }
+
+    // Resultado de una generación del enjambre / de una llamada de búsqueda
+    // local: evaluaciones gastadas y reducción del mejor fitness
+    void swarm_step(long long fes, double gain);
+    void ls_step(long long fes, double gain);
+
+    double share() const { return share_; }
+    long long swarm_fes() const { return swarm_fes_; }
+    long long ls_fes() const { return ls_fes_; }
+    double swarm_gain() const { return swarm_gain_; }
+    double ls_gain() const { return ls_gain_; }
+    int ls_calls() const { return ls_calls_; }
+
+    // Estado del reparto, para los checkpoints
+    void save(CheckpointWriter& out) const;
+    void restore(CheckpointReader& in);
+
+private:
+    void rebalance();
+
+    double share_;
+    long long quota_;
+    double swarm_rate_ = 0.0;   // mejora por evaluación (media exponencial)
+    double ls_rate_ = 0.0;
+    bool swarm_seen_ = false;
+    bool ls_seen_ = false;
+    long long swarm_fes_ = 0;
+    long long ls_fes_ = 0;
+    double swarm_gain_ = 0.0;
+    double ls_gain_ = 0.0;
+    int ls_calls_ = 0;
+};
+
+#endif // LS_SCHEDULER_H
@@ -6,9 +6,34 @@
 #include <fstream>
 #include <iomanip>
 #include "firefly.h"
+#include "engine.h"
+#include "random_search.h"
+#include "multistart_soliswets.h"
+#include "grid_scheduler.h"
+#include "milestone_stats.h"
+#include "rng.h"
+#include "termination.h"
+#include "trace.h"
+#include "event_log.h"
+#include "result_cache.h"
+#include <functional>
+#include <memory>
+#include <sstream>
 
 namespace fs = std::filesystem;
 
+// Milestones de una ejecución completa en results_F_D.txt (ratios de cec17.c)
+const int MILESTONES = 14;
+
+// Mensajes de main con el mismo filtro que los de cada ejecución
+// (--log-level); los que no llegan al nivel se descartan
+LogLevel nivel_log = LogLevel::INFO;
+
+std::ostream& salida(LogLevel level) {
+    static std::ostream descartados(nullptr);
+    return level <= nivel_log ? std::cout : descartados;
+}
+
 void crear_directorio_si_no_existe(const fs::path& dir) {
     if (fs::exists(dir)) {
         if (!fs::is_directory(dir)) {
@@ -20,6 +45,88 @@ void crear_directorio_si_no_existe(const fs::path& dir) {
     }
 }
 
+fs::path fichero_salida(const std::string& alg_name, const std::string& prefijo, int f, int dim) {
+    return fs::path("results_" + alg_name) / (prefijo + "_" + std::to_string(f) + "_" + std::to_string(dim) + ".txt");
+}
+
+fs::path fichero_checkpoint(const std::string& alg_name, int f, int dim) {
+    return fs::path("results_" + alg_name) / ("checkpoint_" + std::to_string(f) + "_" + std::to_string(dim) + ".bin");
+}
+
+// Milestones (líneas tras la cabecera) de un fichero de resultados
+int milestones_escritos(const fs::path& file) {
+    std::ifstream in(file);
+    std::string line;
+    int lines = 0;
+    while (std::getline(in, line)) if (!line.empty()) ++lines;
+    return std::max(0, lines - 1);
+}
+
+// Crea el directorio de resultados de alg_name y dice si hay que ejecutar
+// el trabajo cuya salida es prefijo_f_dim.txt. Si la caché tiene guardados
+// con su clave (la misma configuración, semilla, versión y datos) todos
+// sus ficheros, se restauran los que falten y se omite. Un fichero de
+// resultados a medias (ejecución interrumpida) se reanuda desde su
+// checkpoint si lo hay y, si no, se borra y se repite. Un resultado
+// completo que no está en la caché no se sustituye sin force.
+bool preparar_salida(const std::string& alg_name, const std::string& prefijo, int f, int dim,
+                     ResultCache& cache, std::uint64_t clave, const std::vector<std::string>& ficheros,
+                     bool force) {
+    const std::string dir = "results_" + alg_name;
+    crear_directorio_si_no_existe(dir);
+
+    fs::path output_file = fichero_salida(alg_name, prefijo, f, dim);
+    fs::path checkpoint = fichero_checkpoint(alg_name, f, dim);
+
+    if (prefijo == "results" && fs::exists(checkpoint)) {
+        salida(LogLevel::INFO) << "♻️ Interrumpido: " << output_file << " → reanudando\n";
+        return true;
+    }
+    bool existe = fs::exists(output_file);
+    bool incompleto = existe && prefijo == "results" && milestones_escritos(output_file) < MILESTONES;
+    if (existe && !incompleto && !force && !cache.known(dir, output_file.filename().string())) {
+        salida(LogLevel::WARN) << "⚠️ Sin clave en la caché: " << output_file
+                               << " → omitiendo (--force para repetirlo)\n";
+        return false;
+    }
+    if (!force && cache.stored(dir, clave, ficheros)) {
+        if (cache.restore(dir, clave, ficheros) > 0)
+            salida(LogLevel::INFO) << "📦 Restaurado de la caché: " << output_file << " → omitiendo\n";
+        else
+            salida(LogLevel::INFO) << "✅ Ya existe: " << output_file << " → omitiendo\n";
+        return false;
+    }
+    if (incompleto) {
+        salida(LogLevel::WARN) << "⚠️ Incompleto: " << output_file << " → repitiendo\n";
+        fs::remove(output_file);
+    } else if (existe) {
+        // Guardado en la caché (o --force): se puede sustituir
+        salida(LogLevel::INFO) << (force ? "🔄 --force: " : "🔄 Otra configuración: ") << output_file
+                               << " → repitiendo\n";
+        fs::remove(output_file);
+    }
+    return true;
+}
+
+// Puntos de la traza: "log:N", "linear:N" o fracciones "F1,F2,..."
+TraceSchedule planificacion_traza(const std::string& spec, long long max_fes) {
+    if (spec.rfind("log:", 0) == 0) return TraceSchedule::log_spaced(std::stoi(spec.substr(4)), max_fes);
+    if (spec.rfind("linear:", 0) == 0) return TraceSchedule::linear(std::stoi(spec.substr(7)), max_fes);
+    std::vector<double> fracciones;
+    std::stringstream ss(spec);
+    for (std::string item; std::getline(ss, item, ',');)
+        if (!item.empty()) fracciones.push_back(std::stod(item));
+    return TraceSchedule::custom(fracciones, max_fes);
+}
+
+// Parte de la clave de la caché de resultados propia de firefly: la
+// huella de sus parámetros, la misma que valida sus checkpoints
+ResultKey clave_firefly(const FireflyParams& params) {
+    ResultKey clave;
+    clave.add("firefly").add(FireflyOptimizer(params).state_key());
+    return clave;
+}
+
 std::string modo_a_string(FireflyMode modo) {
     switch (modo) {
         case FireflyMode::BASIC:        return "basic";
@@ -29,7 +136,177 @@ std::string modo_a_string(FireflyMode modo) {
     return "unknown";
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Opciones: --sync (actualización síncrona en paralelo),
+    //           --speculative (secuencial especulativa en paralelo),
+    //           --async (estado estacionario con evaluadores asíncronos), --threads N,
+    //           --seed S (semilla base, cada trabajo deriva la suya),
+    //           --solis (Solis-Wets como búsqueda local), --ls-pair (sondas a la vez),
+    //           --alg firefly|random|solis (algoritmo a ejecutar),
+    //           --jobs N (trabajos a la vez; por defecto todos los núcleos si la
+    //           actualización es secuencial y sin islas y 1 si no, porque cada uno
+    //           ya usa varios hilos),
+    //           --runs N (ejecuciones independientes por configuración; con N > 1
+    //           se escribe stats_F_D.txt con la media, mediana, desviación, mejor y
+    //           peor error por milestone), --raw (con N > 1, guardar también los
+    //           milestones de cada ejecución en results_F_D.txt, con su número en
+    //           la columna run),
+    //           --islands K (modelo de islas con K subenjambres en K hilos),
+    //           --topology ring|full, --migration G (generaciones entre migraciones),
+    //           --checkpoint N (guardar el estado cada N FEs para reanudar una
+    //           ejecución interrumpida; solo firefly con --runs 1, sin islas ni --async),
+    //           paradas anticipadas (los milestones que faltan se completan con
+    //           el mejor al parar): --stop-target [E] (error < E, por defecto
+    //           1e-8), --stop-stagnation N (N FEs sin mejorar), --stop-diversity EPS
+    //           (diversidad del enjambre < EPS), --deadline S (S segundos por ejecución),
+    //           --trace log:N|linear:N|F1,F2,... (traza binaria de convergencia en
+    //           trace_F_D.bin: cada mejora y el mejor en N puntos logarítmicos o
+    //           lineales, o en las fracciones del presupuesto dadas),
+    //           --binary (además, un registro binario por ejecución en
+    //           results_F_D.bin, para agregarlos con aggregate_results),
+    //           --save-best (mejor posición en best_F_D.bin), --snapshots K [f32|delta16]
+    //           (firefly: el enjambre cada K generaciones en swarm_F_D.bin, en float
+    //           o cuantizado a 16 bits y en diferencias; sin islas),
+    //           --perf-counters (con FIREFLY_PROFILE, además ciclos, instrucciones y
+    //           fallos de caché y de salto de cada fase en el resumen; perf_event, Linux;
+    //           solo con --runs 1 --jobs 1),
+    //           --log-level error|warn|info|debug (por defecto info: avisos y resúmenes;
+    //           warn solo avisos, error nada; debug añade cada mejora y el progreso),
+    //           --log-json FICHERO (además, una línea JSON por evento de cada
+    //           ejecución, escrita por un hilo aparte),
+    //           --force (repetir los trabajos aunque la caché de resultados los
+    //           tenga, y sustituir los resultados que no están en ella)
+    FireflyUpdate update = FireflyUpdate::SEQUENTIAL;
+    int num_threads = 0;
+    unsigned long long seed_base = 42;
+    LocalSearch local_search = LocalSearch::COORDINATE;
+    bool ls_batch_pair = false;
+    std::string alg = "firefly";
+    int num_jobs = -1;
+    int runs = 1;
+    bool raw = false;
+    int islands = 1;
+    IslandTopology topology = IslandTopology::RING;
+    int migration_interval = 10;
+    long long checkpoint_fes = 0;
+    std::vector<std::shared_ptr<const TerminationPolicy>> termination;
+    ResultKey clave_parada;   // paradas anticipadas, parte de la clave de cada trabajo
+    std::string trace;
+    bool binary = false;
+    bool save_best = false;
+    bool perf_counters = false;
+    bool force = false;
+    int snapshots = 0;
+    double stop_diversity = -1.0;   // < 0: sin parada por diversidad
+    SnapshotEncoding snapshot_encoding = SnapshotEncoding::FLOAT32;
+    LogLevel log_level = LogLevel::INFO;
+    std::string log_json;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--sync") {
+            update = FireflyUpdate::SYNCHRONOUS;
+        } else if (arg == "--speculative") {
+            update = FireflyUpdate::SPECULATIVE;
+        } else if (arg == "--async") {
+            update = FireflyUpdate::ASYNC;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            num_threads = std::stoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed_base = std::stoull(argv[++i]);
+        } else if (arg == "--solis") {
+            local_search = LocalSearch::SOLIS_WETS;
+        } else if (arg == "--ls-pair") {
+            ls_batch_pair = true;
+        } else if (arg == "--alg" && i + 1 < argc &&
+                   (std::string(argv[i + 1]) == "firefly" || std::string(argv[i + 1]) == "random" ||
+                    std::string(argv[i + 1]) == "solis")) {
+            alg = argv[++i];
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            num_jobs = std::stoi(argv[++i]);
+        } else if (arg == "--runs" && i + 1 < argc) {
+            runs = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--raw") {
+            raw = true;
+        } else if (arg == "--islands" && i + 1 < argc) {
+            islands = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--topology" && i + 1 < argc &&
+                   (std::string(argv[i + 1]) == "ring" || std::string(argv[i + 1]) == "full")) {
+            topology = std::string(argv[++i]) == "ring" ? IslandTopology::RING : IslandTopology::FULL;
+        } else if (arg == "--migration" && i + 1 < argc) {
+            migration_interval = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            checkpoint_fes = std::max(0LL, std::stoll(argv[++i]));
+        } else if (arg == "--stop-target") {
+            bool valor = i + 1 < argc && argv[i + 1][0] != '-';
+            double target = valor ? std::stod(argv[++i]) : 1e-8;
+            termination.push_back(std::make_shared<TargetError>(target));
+            clave_parada.add(arg).add(target);
+        } else if (arg == "--stop-stagnation" && i + 1 < argc) {
+            long long fes = std::stoll(argv[++i]);
+            termination.push_back(std::make_shared<Stagnation>(fes));
+            clave_parada.add(arg).add(fes);
+        } else if (arg == "--stop-diversity" && i + 1 < argc) {
+            stop_diversity = std::max(0.0, std::stod(argv[++i]));
+        } else if (arg == "--deadline" && i + 1 < argc) {
+            double seconds = std::stod(argv[++i]);
+            termination.push_back(std::make_shared<Deadline>(seconds));
+            clave_parada.add(arg).add(seconds);
+        } else if (arg == "--trace" && i + 1 < argc) {
+            trace = argv[++i];
+        } else if (arg == "--binary") {
+            binary = true;
+        } else if (arg == "--save-best") {
+            save_best = true;
+        } else if (arg == "--perf-counters") {
+            perf_counters = true;
+        } else if (arg == "--force") {
+            force = true;
+        } else if (arg == "--snapshots" && i + 1 < argc) {
+            snapshots = std::max(1, std::stoi(argv[++i]));
+            if (i + 1 < argc && (std::string(argv[i + 1]) == "f32" || std::string(argv[i + 1]) == "delta16"))
+                snapshot_encoding = std::string(argv[++i]) == "f32" ? SnapshotEncoding::FLOAT32
+                                                                    : SnapshotEncoding::DELTA16;
+        } else if (arg == "--log-level" && i + 1 < argc && parse_log_level(argv[i + 1], log_level)) {
+            ++i;
+        } else if (arg == "--log-json" && i + 1 < argc) {
+            log_json = argv[++i];
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--alg firefly|random|solis] [--sync | --speculative | --async]"
+                      << " [--threads N] [--jobs N] [--runs N] [--raw] [--seed S] [--solis] [--ls-pair]"
+                      << " [--islands K] [--topology ring|full] [--migration G] [--checkpoint N]"
+                      << " [--stop-target [E]] [--stop-stagnation N] [--stop-diversity EPS] [--deadline S]"
+                      << " [--trace log:N|linear:N|F1,F2,...] [--binary] [--save-best]"
+                      << " [--snapshots K [f32|delta16]] [--perf-counters] [--force]"
+                      << " [--log-level error|warn|info|debug] [--log-json FICHERO]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    nivel_log = log_level;
+    if (checkpoint_fes > 0 && (alg != "firefly" || runs > 1 || islands > 1 || update == FireflyUpdate::ASYNC))
+        salida(LogLevel::WARN) << "⚠️ --checkpoint solo se aplica a firefly con --runs 1, sin islas ni --async\n";
+    if (perf_counters && !PhaseProfile::enabled)
+        salida(LogLevel::WARN) << "⚠️ --perf-counters necesita compilar con -DFIREFLY_PROFILE=ON\n";
+    // Con varias ejecuciones a la vez los grupos de contadores se reparten
+    // la PMU y se mezclan las cachés de unas y otras
+    if (num_jobs < 0) num_jobs = update == FireflyUpdate::SEQUENTIAL && islands == 1 ? 0 : 1;
+    if (perf_counters && (runs > 1 || num_jobs != 1)) {
+        salida(LogLevel::WARN) << "⚠️ --perf-counters solo se aplica con --runs 1 --jobs 1\n";
+        perf_counters = false;
+    }
+    if (snapshots > 0 && (alg != "firefly" || islands > 1)) {
+        salida(LogLevel::WARN) << "⚠️ --snapshots solo se aplica a firefly sin islas\n";
+        snapshots = 0;
+    }
+    // Solo firefly secuencial/síncrono/especulativo mide la diversidad del
+    // enjambre; en el resto la parada no llegaría a cumplirse nunca
+    if (stop_diversity >= 0 && (alg != "firefly" || islands > 1 || update == FireflyUpdate::ASYNC)) {
+        salida(LogLevel::WARN) << "⚠️ --stop-diversity solo se aplica a firefly sin islas ni --async\n";
+    } else if (stop_diversity >= 0) {
+        termination.push_back(std::make_shared<DiversityCollapse>(stop_diversity));
+        clave_parada.add("--stop-diversity").add(stop_diversity);
+    }
+
     fs::path data_dir = "input_data";
     std::vector<fs::path> files;
 
@@ -52,12 +329,122 @@ int main() {
         FireflyMode::ELITISTA
     };
 
+    std::unique_ptr<EventLog> events;
+    if (!log_json.empty()) events = std::make_unique<EventLog>(log_json, log_level);
+
+    GridScheduler grid(num_jobs, log_level >= LogLevel::INFO);
+
+    // Encola las ejecuciones de una configuración. Con varias, cada una usa
+    // su semilla derivada y sus milestones se agregan en memoria; la última
+    // en terminar escribe stats_F_D.txt. clave lleva el algoritmo, su
+    // versión y sus parámetros; aquí se añade el resto de lo que determina
+    // el resultado, y al terminar se apunta en el manifiesto.
+    ResultCache cache;
+    auto encolar = [&](const EngineConfig& config, ResultKey clave, const std::string& etiqueta,
+                       std::function<void(Engine&)> ejecutar) {
+        const int f = config.func_id, dim = config.dim;
+        clave.add(f).add(dim).add(config.max_fes).add(config.lower_bound).add(config.upper_bound)
+             .add(config.seed).add(runs).add(raw).add(clave_parada.value())
+             .add(cache.data_checksum(f, dim));
+        // Los ficheros opcionales también dependen de sus opciones
+        clave.add(binary).add(trace).add(save_best).add(snapshots).add(snapshot_encoding);
+        const std::uint64_t clave_final = clave.value();
+        const std::string prefijo = runs > 1 ? "stats" : "results";
+        const std::string dir = "results_" + config.alg_name;
+
+        // Ficheros binarios propios de cada ejecución
+        auto fichero_run = [&](const std::string& tipo, int r) {
+            std::string sufijo = runs > 1 ? "_run" + std::to_string(r + 1) : "";
+            return tipo + "_" + std::to_string(f) + "_" + std::to_string(dim) + sufijo + ".bin";
+        };
+        fs::path record_file = fichero_salida(config.alg_name, "results", f, dim).replace_extension(".bin");
+        // Todo lo que escribe el trabajo, para la caché
+        std::vector<std::string> ficheros{fichero_salida(config.alg_name, prefijo, f, dim).filename().string()};
+        if (runs > 1 && raw) ficheros.push_back(fichero_salida(config.alg_name, "results", f, dim).filename().string());
+        if (binary) ficheros.push_back(record_file.filename().string());
+        for (int r = 0; r < runs; ++r) {
+            if (!trace.empty()) ficheros.push_back(fichero_run("trace", r));
+            if (save_best) ficheros.push_back(fichero_run("best", r));
+            if (snapshots > 0) ficheros.push_back(fichero_run("swarm", r));
+        }
+        if (!preparar_salida(config.alg_name, prefijo, f, dim, cache, clave_final, ficheros, force)) return;
+
+        // Los registros binarios de una pasada anterior sin terminar no cuentan
+        if (binary) fs::remove(record_file);
+
+        std::shared_ptr<MilestoneStats> stats;
+        fs::path stats_file = fichero_salida(config.alg_name, "stats", f, dim);
+        if (runs > 1) {
+            stats = std::make_shared<MilestoneStats>(f, dim, runs);
+            // Las ejecuciones de una pasada anterior sin terminar no cuentan
+            if (raw) std::ofstream(fichero_salida(config.alg_name, "results", f, dim))
+                         << "funcid,dim,milestone,error,run\n";
+        }
+
+        for (int r = 0; r < runs; ++r) {
+            std::ostringstream header;
+            if (log_level >= LogLevel::INFO) {
+                header << "=====================================================\n";
+                header << "Función: F" << f
+                       << " | Dim=" << dim
+                       << " | " << etiqueta;
+                if (runs > 1) header << " | Run=" << r + 1 << "/" << runs;
+                header << " | MaxFEs=" << config.max_fes << "\n";
+            }
+
+            EngineConfig job_config = config;
+            job_config.seed = derive_seed(config.seed, r);
+            job_config.termination = termination;
+            job_config.log_level = log_level;
+            job_config.events = events.get();
+            job_config.hw_counters = perf_counters;
+            if (binary) job_config.record_path = record_file.string();
+            if (!trace.empty()) {
+                job_config.trace_path = (fs::path(dir) / fichero_run("trace", r)).string();
+                job_config.trace_schedule = planificacion_traza(trace, config.max_fes);
+            }
+            if (save_best) job_config.best_path = (fs::path(dir) / fichero_run("best", r)).string();
+            if (snapshots > 0) {
+                job_config.snapshot_path = (fs::path(dir) / fichero_run("swarm", r)).string();
+                job_config.snapshot_every = snapshots;
+                job_config.snapshot_encoding = snapshot_encoding;
+            }
+            if (stats) {
+                job_config.write_output = raw;
+                job_config.run = r + 1;
+                job_config.on_milestone = [stats, r](int milestone, double error) {
+                    stats->record(r, milestone, error);
+                };
+            }
+            std::string name = config.alg_name + "_F" + std::to_string(f);
+            if (runs > 1) name += "_run" + std::to_string(r + 1);
+
+            grid.add({name, header.str(), f, dim, grid_cost(f, dim, config.max_fes),
+                      [job_config, ejecutar, stats, stats_file, dir, ficheros, clave_final,
+                       &cache](std::ostream& log) {
+                          EngineConfig c = job_config;
+                          c.log = &log;
+                          {
+                              Engine engine(c);
+                              ejecutar(engine);
+                          }
+                          if (!stats) {
+                              cache.record(dir, clave_final, ficheros);
+                          } else if (stats->finish_run() && stats->write(stats_file.string())) {
+                              if (c.log_level >= LogLevel::INFO)
+                                  log << "📊 " << stats->runs() << " ejecuciones → " << stats_file << "\n";
+                              cache.record(dir, clave_final, ficheros);
+                          }
+                      }});
+        }
+    };
+
     for (const auto& file_path : files) {
         std::string filename = file_path.filename().string();
         std::smatch match;
 
         if (!std::regex_match(filename, match, m_format)) {
-            std::cout << "⚠️ No válido: " << filename << " → omitiendo\n";
+            salida(LogLevel::WARN) << "⚠️ No válido: " << filename << " → omitiendo\n";
             continue;
         }
 
@@ -65,7 +452,33 @@ int main() {
         int dim = std::stoi(match[2]);
 
         if (dim != 10 && dim != 30 && dim != 50) {
-            std::cout << "❌ Dimensión ignorada (" << dim << "): " << filename << "\n";
+            salida(LogLevel::WARN) << "❌ Dimensión ignorada (" << dim << "): " << filename << "\n";
+            continue;
+        }
+
+        // Algoritmos de referencia sobre el mismo motor y presupuesto
+        if (alg != "firefly") {
+            EngineConfig config{dim, f, (alg == "random" ? "RandomD" : "SolisWetsD") + std::to_string(dim),
+                                10000LL * dim};
+            config.seed = seed_base + 1000ULL * f + dim;
+            // En secuencial no hace falta pool
+            config.num_threads = update == FireflyUpdate::SEQUENTIAL ? 1 : num_threads;
+
+            const int reinicios = 5;
+            ResultKey clave;
+            clave.add(alg).add(alg == "random" ? RandomSearch::VERSION : MultiStartSolisWets::VERSION);
+            if (alg != "random") clave.add(reinicios);
+            encolar(config, clave, "Algoritmo=" + alg, [alg](Engine& engine) {
+                if (alg == "random") {
+                    RandomSearch random;
+                    engine.run(random);
+                } else {
+                    SolisWetsParams sw_params;
+                    sw_params.delta = (engine.upper_bound() - engine.lower_bound()) * 0.1;
+                    MultiStartSolisWets solis(reinicios, sw_params);
+                    engine.run(solis);
+                }
+            });
             continue;
         }
 
@@ -80,30 +493,46 @@ int main() {
             params.max_fes       = 10000LL * dim;
             params.T             = 10;
             params.mode          = modo;
+            params.archive_size  = ARCHIVE_SIZE_DEFAULT;
+            params.local_search  = local_search;
+            params.ls_batch_pair = ls_batch_pair;
+            params.update        = update;
+            params.num_threads   = num_threads;
+            params.seed          = seed_base + 1000ULL * f + dim;
+            params.islands       = islands;
+            params.topology      = topology;
+            params.migration_interval = migration_interval;
 
             std::string modo_str = modo_a_string(modo);
+            if (update == FireflyUpdate::SYNCHRONOUS) modo_str += "_sync";
+            if (update == FireflyUpdate::ASYNC) modo_str += "_async";
+            if (islands > 1) {
+                modo_str += "_isl" + std::to_string(islands);
+                if (topology == IslandTopology::FULL) modo_str += "_full";
+            }
+            if (modo == FireflyMode::LOCAL_SEARCH && local_search == LocalSearch::SOLIS_WETS)
+                modo_str += ls_batch_pair ? "_sw_pair" : "_sw";
             std::string alg_name = "MyFireflyD" + std::to_string(dim) + "_" + modo_str;
-            fs::path results_dir = "results_" + alg_name;
-
-            crear_directorio_si_no_existe(results_dir);
 
-            fs::path output_file = results_dir / ("results_" + std::to_string(f) + "_" + std::to_string(dim) + ".txt");
-
-            if (fs::exists(output_file)) {
-                std::cout << "✅ Ya existe: " << output_file << " → omitiendo\n";
-                continue;
+            // Cada ejecución escribe sus milestones (fichero o agregado)
+            EngineConfig config = firefly_engine_config(dim, f, params, alg_name);
+            if (checkpoint_fes > 0 && runs == 1 && islands == 1 && update != FireflyUpdate::ASYNC) {
+                config.checkpoint_path = fichero_checkpoint(alg_name, f, dim).string();
+                config.checkpoint_fes = checkpoint_fes;
             }
-
-            std::cout << "=====================================================\n";
-            std::cout << "Función: F" << f
-                      << " | Dim=" << dim
-                      << " | Modo=" << modo_str
-                      << " | MaxFEs=" << params.max_fes << "\n";
-
-            // Esta función debe encargarse de escribir el archivo completo con múltiples milestones
-            run_firefly_algorithm(dim, f, params, alg_name);
+            encolar(config, clave_firefly(params), "Modo=" + modo_str,
+                    [params](Engine& engine) {
+                        FireflyOptimizer firefly(params);
+                        engine.run(firefly);
+                    });
         }
     }
 
+    if (grid.size() > 0) {
+        salida(LogLevel::INFO) << "🧵 " << grid.size() << " trabajos en " << grid.workers() << " hilos\n";
+        grid.run();
+        grid.write_timings("grid_times.csv");
+    }
+
     return 0;
 }
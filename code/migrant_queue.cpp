@@ -0,0 +1,29 @@
+// migrant_queue.cpp
+#include "migrant_queue.h"
+#include <algorithm>
+
+MigrantQueue::MigrantQueue(int capacity, int dim, Arena& arena)
+    : capacity_(capacity > 0 ? capacity : 1), dim_(dim),
+      pos_((size_t)capacity_ * dim, ArenaAllocator<double>(&arena)),
+      fit_(capacity_, ArenaAllocator<double>(&arena)) {}
+
+// head_ y tail_ solo crecen; su diferencia es el número de registros
+bool MigrantQueue::push(const double* position, double fitness) {
+    unsigned tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == capacity_) return false;
+    unsigned slot = tail % capacity_;
+    std::copy(position, position + dim_, &pos_[(size_t)slot * dim_]);
+    fit_[slot] = fitness;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool MigrantQueue::pop(double* position, double& fitness) {
+    unsigned head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) return false;
+    unsigned slot = head % capacity_;
+    std::copy(&pos_[(size_t)slot * dim_], &pos_[(size_t)(slot + 1) * dim_], position);
+    fitness = fit_[slot];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
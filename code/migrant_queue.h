@@ -0,0 +1,33 @@
+// migrant_queue.h
+#ifndef MIGRANT_QUEUE_H
+#define MIGRANT_QUEUE_H
+
+#include <atomic>
+#include "arena.h"
+
+// Cola sin bloqueos de un productor y un consumidor para los emigrantes de
+// una isla a otra. Capacidad fija: cada registro es una posición de D
+// coordenadas y su fitness, en un bloque reservado al crearla.
+class MigrantQueue {
+public:
+    MigrantQueue(int capacity, int dim, Arena& arena);
+
+    MigrantQueue(const MigrantQueue&) = delete;
+    MigrantQueue& operator=(const MigrantQueue&) = delete;
+
+    // Productor: false si está llena (el emigrante se descarta)
+    bool push(const double* position, double fitness);
+
+    // Consumidor: false si está vacía
+    bool pop(double* position, double& fitness);
+
+private:
+    unsigned capacity_;
+    int dim_;
+    ArenaVector<double> pos_;   // capacidad x D
+    ArenaVector<double> fit_;
+    alignas(64) std::atomic<unsigned> head_{0};   // siguiente a leer
+    alignas(64) std::atomic<unsigned> tail_{0};   // siguiente a escribir
+};
+
+#endif // MIGRANT_QUEUE_H
@@ -0,0 +1,49 @@
+// milestone_stats.cpp
+#include "milestone_stats.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+MilestoneStats::MilestoneStats(int func_id, int dim, int runs)
+    : func_id_(func_id), dim_(dim), runs_(runs), remaining_(runs),
+      count_(runs, 0), milestone_((std::size_t)runs * MAX_MILESTONES, 0),
+      error_((std::size_t)runs * MAX_MILESTONES, 0.0) {}
+
+void MilestoneStats::record(int run, int milestone, double error) {
+    int k = count_[run];
+    if (k >= MAX_MILESTONES) return;
+    milestone_[(std::size_t)run * MAX_MILESTONES + k] = milestone;
+    error_[(std::size_t)run * MAX_MILESTONES + k] = error;
+    count_[run] = k + 1;
+}
+
+bool MilestoneStats::write(const std::string& path) const {
+    FILE* out = std::fopen(path.c_str(), "w");
+    if (out == nullptr) {
+        std::cerr << "Error: no se puede escribir " << path << "\n";
+        return false;
+    }
+    std::fprintf(out, "funcid,dim,milestone,runs,mean,median,std,best,worst\n");
+
+    int complete = *std::min_element(count_.begin(), count_.end());
+    std::vector<double> errors(runs_);
+    for (int k = 0; k < complete; ++k) {
+        double sum = 0.0;
+        for (int r = 0; r < runs_; ++r) {
+            errors[r] = error_[(std::size_t)r * MAX_MILESTONES + k];
+            sum += errors[r];
+        }
+        std::sort(errors.begin(), errors.end());
+        double mean = sum / runs_;
+        double median = runs_ % 2 ? errors[runs_ / 2]
+                                  : 0.5 * (errors[runs_ / 2 - 1] + errors[runs_ / 2]);
+        double var = 0.0;
+        for (double e : errors) var += (e - mean) * (e - mean);
+        double sd = runs_ > 1 ? std::sqrt(var / (runs_ - 1)) : 0.0;
+        std::fprintf(out, "%d,%d,%d,%d,%e,%e,%e,%e,%e\n", func_id_, dim_, milestone_[k], runs_,
+                     mean, median, sd, errors.front(), errors.back());
+    }
+    std::fclose(out);
+    return true;
+}
@@ -0,0 +1,40 @@
+// milestone_stats.h
+#ifndef MILESTONE_STATS_H
+#define MILESTONE_STATS_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+// Errores por milestone de varias ejecuciones independientes de una misma
+// configuración (función, dimensión, algoritmo). Cada ejecución escribe solo
+// en su fila, así que todas pueden registrar a la vez sin bloqueos.
+class MilestoneStats {
+public:
+    MilestoneStats(int func_id, int dim, int runs);
+
+    int runs() const { return runs_; }
+
+    // Milestone de la ejecución run, en el orden en que llegan
+    void record(int run, int milestone, double error);
+
+    // Marca una ejecución como terminada; devuelve true solo para la última
+    bool finish_run() { return remaining_.fetch_sub(1) == 1; }
+
+    // Escribe por milestone: funcid,dim,milestone,runs,mean,median,std,best,worst
+    // (std muestral). Solo entran los milestones a los que llegaron todas.
+    bool write(const std::string& path) const;
+
+private:
+    static const int MAX_MILESTONES = 14;
+
+    int func_id_;
+    int dim_;
+    int runs_;
+    std::atomic<int> remaining_;
+    std::vector<int> count_;          // milestones recibidos por ejecución
+    std::vector<int> milestone_;      // runs x MAX_MILESTONES
+    std::vector<double> error_;       // runs x MAX_MILESTONES
+};
+
+#endif // MILESTONE_STATS_H
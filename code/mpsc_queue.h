@@ -0,0 +1,73 @@
+// mpsc_queue.h
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Cola sin bloqueos de varios productores y un consumidor (anillo de
+// Vyukov). Capacidad fija, potencia de 2, reservada al crearla: push y pop
+// no reservan memoria ni esperan, y si está llena push devuelve false.
+template <class T>
+class MpscQueue {
+public:
+    explicit MpscQueue(std::size_t capacity) {
+        std::size_t n = 1;
+        while (n < capacity) n <<= 1;
+        mask_ = n - 1;
+        cells_ = std::make_unique<Cell[]>(n);
+        for (std::size_t i = 0; i < n; ++i) cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+    // Productores: cada hueco lleva un número de secuencia que dice si está
+    // libre para la posición pos; el que gana la posición escribe y publica
+    bool push(const T& value) {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            std::size_t seq = cell.seq.load(std::memory_order_acquire);
+            std::intptr_t dif = (std::intptr_t)seq - (std::intptr_t)pos;
+            if (dif == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (dif < 0) {
+                return false;   // llena
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumidor (uno solo): false si está vacía
+    bool pop(T& value) {
+        Cell& cell = cells_[head_ & mask_];
+        if (cell.seq.load(std::memory_order_acquire) != head_ + 1) return false;
+        value = cell.value;
+        cell.seq.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> seq;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_ = 0;
+    alignas(64) std::atomic<std::size_t> tail_{0};   // siguiente a escribir
+    alignas(64) std::size_t head_ = 0;               // siguiente a leer
+};
+
+#endif // MPSC_QUEUE_H
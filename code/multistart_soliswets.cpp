@@ -0,0 +1,27 @@
+// multistart_soliswets.cpp
+#include "multistart_soliswets.h"
+#include "engine.h"
+
+MultiStartSolisWets::MultiStartSolisWets(int restarts, const SolisWetsParams& params)
+    : restarts_(restarts > 0 ? restarts : 1), params_(params) {}
+
+void MultiStartSolisWets::optimize(Engine& engine) {
+    const int dim = engine.dim();
+    const double lo = engine.lower_bound(), hi = engine.upper_bound();
+    ArenaAllocator<double> alloc(&engine.arena());
+    ArenaVector<double> sol(dim, alloc), bias(dim, alloc), dif(dim, alloc), newsol(2 * dim, alloc);
+    SolisWetsBuffers buf{bias.data(), dif.data(), newsol.data()};
+    SolisWetsParams params = params_;
+    params.lower = lo;
+    params.upper = hi;
+    LsEvaluator eval = engine.ls_evaluator();
+
+    for (int r = 0; r < restarts_ && !engine.exhausted(); ++r) {
+        // La primera evaluación del reinicio es la de la solución inicial
+        long long quota = engine.remaining() / (restarts_ - r);
+        for (int i = 0; i < dim; ++i) sol[i] = engine.rng().uniform(lo, hi);
+        double fitness = engine.evaluate(sol.data());
+        soliswets(sol.data(), fitness, dim, quota - 1, params, engine.rng(), buf, eval);
+        engine.report_progress();
+    }
+}
@@ -0,0 +1,25 @@
+// multistart_soliswets.h
+#ifndef MULTISTART_SOLISWETS_H
+#define MULTISTART_SOLISWETS_H
+
+#include "optimizer.h"
+#include "soliswets.h"
+
+// Solis-Wets desde restarts soluciones aleatorias, con el presupuesto del
+// motor repartido a partes iguales entre los reinicios. Los límites de
+// params se sustituyen por los del motor.
+class MultiStartSolisWets : public Optimizer {
+public:
+    MultiStartSolisWets(int restarts, const SolisWetsParams& params);
+
+    static constexpr int VERSION = 1;   // ver FireflyOptimizer::VERSION
+
+    const char* name() const override { return "soliswets"; }
+    void optimize(Engine& engine) override;
+
+private:
+    int restarts_;
+    SolisWetsParams params_;
+};
+
+#endif // MULTISTART_SOLISWETS_H
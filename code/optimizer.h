@@ -0,0 +1,27 @@
+// optimizer.h
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include <cstdint>
+
+class Engine;
+
+// Algoritmo de optimización que se ejecuta sobre el motor común (engine.h).
+// El motor pone el evaluador, el generador, el presupuesto, la arena y los
+// hilos; el algoritmo solo decide qué soluciones evaluar.
+class Optimizer {
+public:
+    virtual ~Optimizer() = default;
+
+    // Nombre corto para mensajes
+    virtual const char* name() const = 0;
+
+    // Huella de los parámetros de los que depende el estado que guarda en
+    // los checkpoints; el motor no reanuda uno guardado con otra
+    virtual std::uint64_t state_key() const { return 0; }
+
+    // Optimiza hasta agotar el presupuesto del motor
+    virtual void optimize(Engine& engine) = 0;
+};
+
+#endif // OPTIMIZER_H
@@ -0,0 +1,181 @@
+// phase_timer.cpp
+#include "phase_timer.h"
+
+#ifdef FIREFLY_PROFILE
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+static const char* PHASE_NAMES[PHASES] = {"inicialización", "atracción", "evaluación",
+                                          "búsqueda local", "archivo élite", "mensajes", "resto"};
+
+// Estado del hilo: bloque donde acumula, fase actual (-1 = ninguna), fase
+// a la que se atribuyen las evaluaciones y último instante contabilizado
+static thread_local PhaseCounters* phase_sink = nullptr;
+static thread_local int phase_current = -1;
+static thread_local int phase_owner = static_cast<int>(Phase::OTHER);
+static thread_local long long phase_last = 0;
+static thread_local std::unique_ptr<HwCounters> phase_hw;
+static thread_local long long phase_hw_last[HW_EVENTS];
+static thread_local long long phase_hw_enabled = 0, phase_hw_running = 0;
+
+static long long phase_now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Carga a la fase actual el tiempo (y los contadores) desde el último cambio.
+// Si el grupo solo ha contado parte del tramo (multiplexado), las cuentas
+// del tramo se escalan por tiempo activo / tiempo contando.
+static void phase_charge() {
+    long long now = phase_now();
+    if (phase_current >= 0) phase_sink->ns[phase_current] += now - phase_last;
+    phase_last = now;
+    if (!phase_hw) return;
+    long long values[HW_EVENTS];
+    long long enabled, running;
+    std::copy(phase_hw_last, phase_hw_last + HW_EVENTS, values);
+    if (!phase_hw->read(values, &enabled, &running)) return;
+    if (phase_current >= 0) {
+        long long active = enabled - phase_hw_enabled, counting = running - phase_hw_running;
+        double scale = counting > 0 && counting < active ? (double)active / counting : 1.0;
+        for (int e = 0; e < HW_EVENTS; ++e)
+            phase_sink->hw[phase_current][e] += std::llround((values[e] - phase_hw_last[e]) * scale);
+    }
+    std::copy(values, values + HW_EVENTS, phase_hw_last);
+    phase_hw_enabled = enabled;
+    phase_hw_running = running;
+}
+
+PhaseScope::PhaseScope(Phase phase) : prev_(phase_current), prev_owner_(phase_owner) {
+    if (phase_sink == nullptr) return;
+    phase_charge();
+    int p = static_cast<int>(phase);
+    if (phase == Phase::EVALUATION) ++phase_sink->evals[phase_owner];
+    else phase_owner = p;
+    phase_current = p;
+}
+
+PhaseScope::~PhaseScope() {
+    if (phase_sink == nullptr) return;
+    phase_charge();
+    phase_current = prev_;
+    phase_owner = prev_owner_;
+}
+
+void PhaseProfile::bind(bool engine_thread) {
+    std::string hw_error;
+    if (hw_) {
+        auto hw = std::make_unique<HwCounters>();
+        std::fill(phase_hw_last, phase_hw_last + HW_EVENTS, 0LL);
+        if (hw->ok() && hw->read(phase_hw_last, &phase_hw_enabled, &phase_hw_running)) phase_hw = std::move(hw);
+        else hw_error = hw->ok() ? "no se pueden leer" : hw->error();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        threads_.push_back(std::make_unique<PhaseCounters>());
+        phase_sink = threads_.back().get();
+        if (phase_hw) {
+            for (int e = 0; e < HW_EVENTS; ++e)
+                hw_has_[e] = phase_hw->has(e) && (hw_threads_ == 0 || hw_has_[e]);
+            ++hw_threads_;
+        } else if (hw_error_.empty()) {
+            hw_error_ = hw_error;
+        }
+    }
+    phase_current = engine_thread ? static_cast<int>(Phase::OTHER) : -1;
+    phase_owner = static_cast<int>(Phase::OTHER);
+    phase_last = phase_now();
+}
+
+void PhaseProfile::unbind() {
+    if (phase_sink == nullptr) return;
+    phase_charge();
+    if (phase_hw) {
+        if (phase_hw->multiplexed()) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            hw_multiplexed_ = true;
+        }
+        phase_hw.reset();
+    }
+    phase_sink = nullptr;
+    phase_current = -1;
+}
+
+void PhaseProfile::report(std::ostream& out, long long fes) const {
+    PhaseCounters total;
+    long long ns = 0, evals = 0;
+    std::size_t threads;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        threads = threads_.size();
+        for (const auto& t : threads_)
+            for (int p = 0; p < PHASES; ++p) {
+                total.ns[p] += t->ns[p];
+                total.evals[p] += t->evals[p];
+                for (int e = 0; e < HW_EVENTS; ++e) total.hw[p][e] += t->hw[p][e];
+            }
+    }
+    for (int p = 0; p < PHASES; ++p) {
+        ns += total.ns[p];
+        evals += total.evals[p];
+    }
+    char line[128];
+    std::snprintf(line, sizeof(line), "Fases: %.3f s en %zu hilos, %lld evaluaciones, %.0f ns/FE\n",
+                  ns * 1e-9, threads, evals, fes > 0 ? (double)ns / fes : 0.0);
+    out << line;
+    for (int p = 0; p < PHASES; ++p) {
+        if (total.ns[p] == 0 && total.evals[p] == 0) continue;
+        // Ancho en caracteres, no en bytes (los nombres llevan tildes)
+        int width = 16;
+        for (const char* c = PHASE_NAMES[p]; *c; ++c) width += (*c & 0xC0) == 0x80;
+        std::snprintf(line, sizeof(line), "  %-*s %6.2f%% tiempo ", width, PHASE_NAMES[p],
+                      ns > 0 ? 100.0 * total.ns[p] / ns : 0.0);
+        out << line;
+        // Las evaluaciones cuentan en la fase que las pide
+        if (p == static_cast<int>(Phase::EVALUATION)) std::snprintf(line, sizeof(line), "%12s", "");
+        else std::snprintf(line, sizeof(line), "%6.2f%% FEs ", evals > 0 ? 100.0 * total.evals[p] / evals : 0.0);
+        out << line;
+        std::snprintf(line, sizeof(line), "%10.0f ns/FE\n", fes > 0 ? (double)total.ns[p] / fes : 0.0);
+        out << line;
+    }
+    if (hw_) report_hw(out, total, fes);
+}
+
+// Un evento que falta en algún hilo no se muestra
+static void put_per_fe(std::ostream& out, const char* name, bool has, long long count, long long fes) {
+    char field[48];
+    if (has && fes > 0) std::snprintf(field, sizeof(field), "  %s %9.3f/FE", name, (double)count / fes);
+    else std::snprintf(field, sizeof(field), "  %s %12s", name, "-");
+    out << field;
+}
+
+void PhaseProfile::report_hw(std::ostream& out, const PhaseCounters& total, long long fes) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (hw_threads_ == 0) {
+        out << "⚠️ Contadores hardware no disponibles: " << hw_error_ << "\n";
+        return;
+    }
+    out << "Contadores hardware (" << hw_threads_ << " de " << threads_.size() << " hilos"
+        << (hw_multiplexed_ ? ", multiplexados y escalados" : "") << "):\n";
+    char line[64];
+    for (int p = 0; p < PHASES; ++p) {
+        const long long* hw = total.hw[p];
+        if (hw[HW_CYCLES] == 0) continue;
+        int width = 16;
+        for (const char* c = PHASE_NAMES[p]; *c; ++c) width += (*c & 0xC0) == 0x80;
+        std::snprintf(line, sizeof(line), "  %-*s", width, PHASE_NAMES[p]);
+        out << line;
+        if (hw_has_[HW_INSTRUCTIONS]) std::snprintf(line, sizeof(line), " IPC %5.2f", (double)hw[HW_INSTRUCTIONS] / hw[HW_CYCLES]);
+        else std::snprintf(line, sizeof(line), " IPC %5s", "-");
+        out << line;
+        put_per_fe(out, "L1d", hw_has_[HW_L1D_MISSES], hw[HW_L1D_MISSES], fes);
+        put_per_fe(out, "LLC", hw_has_[HW_LLC_MISSES], hw[HW_LLC_MISSES], fes);
+        put_per_fe(out, "saltos", hw_has_[HW_BRANCH_MISSES], hw[HW_BRANCH_MISSES], fes);
+        out << "\n";
+    }
+}
+
+#endif
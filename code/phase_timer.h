@@ -0,0 +1,118 @@
+// phase_timer.h
+#ifndef PHASE_TIMER_H
+#define PHASE_TIMER_H
+
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "hw_counters.h"
+
+// Temporizadores por fase del bucle caliente. Solo existen si se compila
+// con FIREFLY_PROFILE (cmake -DFIREFLY_PROFILE=ON); si no, PHASE_SCOPE no
+// genera código y PhaseProfile no hace nada.
+//
+// Cada hilo acumula en su propio bloque, sin atómicos ni cerrojos, el
+// tiempo exclusivo de cada fase: una fase anidada (la evaluación dentro de
+// la atracción) se descuenta de la que la contiene. Las evaluaciones se
+// atribuyen a la fase que las pide (la no EVALUATION más interna).
+//
+// Opcionalmente (set_hw_counters) cada hilo abre además un grupo de
+// contadores hardware (hw_counters.h) y los reparte entre las fases igual
+// que el tiempo. Cada cambio de fase lee entonces el grupo con una llamada
+// al sistema, así que solo conviene para medir, no para las ejecuciones.
+enum class Phase {
+    INIT,           // enjambre inicial
+    ATTRACTION,     // movimientos del enjambre
+    EVALUATION,     // evaluador CEC17
+    LOCAL_SEARCH,   // memetic_local_search / Solis-Wets
+    ARCHIVE,        // elitist_archive
+    LOGGING,        // mensajes de progreso
+    OTHER           // resto del hilo del motor
+};
+const int PHASES = static_cast<int>(Phase::OTHER) + 1;
+
+struct alignas(64) PhaseCounters {
+    long long ns[PHASES] = {};
+    long long evals[PHASES] = {};
+    long long hw[PHASES][HW_EVENTS] = {};
+};
+
+// Tiempos de una ejecución: un bloque por hilo que ha trabajado en ella
+class PhaseProfile {
+public:
+#ifdef FIREFLY_PROFILE
+    static constexpr bool enabled = true;
+
+    // Antes de bind: también contadores hardware en los hilos que se unan
+    void set_hw_counters(bool on) { hw_ = on; }
+
+    // El hilo actual acumula en un bloque nuevo hasta unbind. El del motor
+    // cuenta todo su tiempo (lo que no está en una fase va a OTHER); los
+    // demás, solo el que pasan dentro de alguna fase.
+    void bind(bool engine_thread = false);
+    void unbind();
+
+    // Desglose por fase: % del tiempo de todos los hilos, % de las
+    // evaluaciones y coste por FE (ns de la fase / fes); con contadores,
+    // además IPC y fallos por FE
+    void report(std::ostream& out, long long fes) const;
+#else
+    static constexpr bool enabled = false;
+
+    void set_hw_counters(bool) {}
+    void bind(bool = false) {}
+    void unbind() {}
+    void report(std::ostream&, long long) const {}
+#endif
+
+private:
+    void report_hw(std::ostream& out, const PhaseCounters& total, long long fes) const;
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<PhaseCounters>> threads_;
+    bool hw_ = false;
+    int hw_threads_ = 0;          // hilos con grupo de contadores
+    bool hw_has_[HW_EVENTS] = {}; // eventos contados en todos ellos
+    bool hw_multiplexed_ = false;
+    std::string hw_error_;        // por qué no se pudo abrir
+};
+
+// Hilo propio de un algoritmo (islas, evaluadores asíncronos) que
+// acumula en profile mientras existe
+class PhaseThread {
+public:
+    explicit PhaseThread(PhaseProfile& profile) : profile_(profile) { profile_.bind(); }
+    ~PhaseThread() { profile_.unbind(); }
+
+private:
+    PhaseProfile& profile_;
+};
+
+#ifdef FIREFLY_PROFILE
+
+class PhaseScope {
+public:
+    explicit PhaseScope(Phase phase);
+    ~PhaseScope();
+
+    PhaseScope(const PhaseScope&) = delete;
+    PhaseScope& operator=(const PhaseScope&) = delete;
+
+private:
+    int prev_;
+    int prev_owner_;
+};
+
+#define PHASE_CONCAT_(a, b) a##b
+#define PHASE_CONCAT(a, b) PHASE_CONCAT_(a, b)
+#define PHASE_SCOPE(phase) PhaseScope PHASE_CONCAT(phase_scope_, __LINE__)(phase)
+
+#else
+
+#define PHASE_SCOPE(phase) ((void)0)
+
+#endif
+
+#endif // PHASE_TIMER_H
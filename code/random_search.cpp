@@ -0,0 +1,20 @@
+// random_search.cpp
+#include "random_search.h"
+#include "engine.h"
+
+RandomSearch::RandomSearch(int batch) : batch_(batch > 0 ? batch : 1) {}
+
+void RandomSearch::optimize(Engine& engine) {
+    const int dim = engine.dim();
+    const double lo = engine.lower_bound(), hi = engine.upper_bound();
+    ArenaVector<double> sols((std::size_t)batch_ * dim, ArenaAllocator<double>(&engine.arena()));
+    ArenaVector<double> fit(batch_, ArenaAllocator<double>(&engine.arena()));
+
+    engine.report_progress();
+    while (!engine.exhausted()) {
+        engine.rng().fill_uniform(sols.data(), sols.size());
+        for (double& x : sols) x = lo + (hi - lo) * x;
+        engine.evaluate_batch(sols.data(), batch_, dim, fit.data());
+        engine.report_progress();
+    }
+}
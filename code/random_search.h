@@ -0,0 +1,22 @@
+// random_search.h
+#ifndef RANDOM_SEARCH_H
+#define RANDOM_SEARCH_H
+
+#include "optimizer.h"
+
+// Búsqueda aleatoria uniforme en los límites del motor. Genera y evalúa
+// las soluciones por lotes, así que con pool se evalúan en paralelo.
+class RandomSearch : public Optimizer {
+public:
+    explicit RandomSearch(int batch = 64);
+
+    static constexpr int VERSION = 1;   // ver FireflyOptimizer::VERSION
+
+    const char* name() const override { return "random"; }
+    void optimize(Engine& engine) override;
+
+private:
+    int batch_;
+};
+
+#endif // RANDOM_SEARCH_H
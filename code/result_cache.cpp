@@ -0,0 +1,141 @@
+// result_cache.cpp
+#include "result_cache.h"
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+static const char* MANIFEST_NAME = "manifest.txt";
+static const char* CACHE_DIR = "cache";
+static const std::uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+void ResultKey::add_bytes(const void* data, std::size_t size) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash_ ^= p[i];
+        hash_ *= FNV_PRIME;
+    }
+}
+
+// Un fichero que falta también cuenta (distinto de uno vacío)
+static void add_file(ResultKey& key, const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    key.add(static_cast<bool>(in));
+    char buf[1 << 16];
+    while (in.read(buf, sizeof(buf)) || in.gcount() > 0)
+        key.add_bytes(buf, (std::size_t)in.gcount());
+}
+
+// Suma del contenido de un fichero; uno que falta tiene la suya propia
+static std::uint64_t file_checksum(const fs::path& path) {
+    ResultKey key;
+    add_file(key, path);
+    return key.value();
+}
+
+// Llamar con el cerrojo tomado
+ResultCache::Manifest& ResultCache::manifest(const std::string& dir) {
+    auto it = manifests_.find(dir);
+    if (it != manifests_.end()) return it->second;
+    Manifest& entries = manifests_[dir];
+    std::ifstream in(fs::path(dir) / MANIFEST_NAME);
+    std::string line, file;
+    std::uint64_t key, sum;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        if (fields >> std::hex >> key >> file >> sum) entries[key][file] = sum;
+    }
+    return entries;
+}
+
+// Copia guardada de file con la clave key
+static fs::path stored_path(const std::string& dir, std::uint64_t key, const std::string& file) {
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016" PRIx64, key);
+    return fs::path(dir) / CACHE_DIR / name / file;
+}
+
+bool ResultCache::stored(const std::string& dir, std::uint64_t key, const std::vector<std::string>& files) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Manifest& entries = manifest(dir);
+    auto it = entries.find(key);
+    if (it == entries.end()) return false;
+    for (const auto& file : files)
+        if (!it->second.count(file) || !fs::exists(stored_path(dir, key, file))) return false;
+    return true;
+}
+
+int ResultCache::restore(const std::string& dir, std::uint64_t key, const std::vector<std::string>& files) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& sums = manifest(dir)[key];
+    int copied = 0;
+    for (const auto& file : files) {
+        auto sum = sums.find(file);
+        fs::path target = fs::path(dir) / file;
+        if (sum != sums.end() && file_checksum(target) == sum->second) continue;
+        std::error_code ec;
+        fs::copy_file(stored_path(dir, key, file), target, fs::copy_options::overwrite_existing, ec);
+        if (ec) std::cerr << "Error: no se puede restaurar " << target << ": " << ec.message() << "\n";
+        else ++copied;
+    }
+    return copied;
+}
+
+bool ResultCache::known(const std::string& dir, const std::string& file) {
+    std::uint64_t sum = file_checksum(fs::path(dir) / file);
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& entry : manifest(dir)) {
+        auto it = entry.second.find(file);
+        if (it != entry.second.end() && it->second == sum) return true;
+    }
+    return false;
+}
+
+void ResultCache::record(const std::string& dir, std::uint64_t key, const std::vector<std::string>& files) {
+    // Las copias, fuera del cerrojo: cada clave es de un solo trabajo
+    std::vector<std::pair<std::string, std::uint64_t>> saved;
+    for (const auto& file : files) {
+        fs::path source = fs::path(dir) / file, copy = stored_path(dir, key, file);
+        std::error_code ec;
+        if (!fs::exists(source)) continue;
+        fs::create_directories(copy.parent_path(), ec);
+        fs::copy_file(source, copy, fs::copy_options::overwrite_existing, ec);
+        if (ec) {
+            std::cerr << "Error: no se puede guardar " << copy << ": " << ec.message() << "\n";
+            continue;
+        }
+        saved.emplace_back(file, file_checksum(source));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& sums = manifest(dir)[key];
+    fs::path manifest_path = fs::path(dir) / MANIFEST_NAME;
+    FILE* out = std::fopen(manifest_path.string().c_str(), "a");
+    if (out == nullptr) {
+        std::cerr << "Error: no se puede escribir " << manifest_path << "\n";
+        return;
+    }
+    for (const auto& file : saved) {
+        sums[file.first] = file.second;
+        std::fprintf(out, "%016" PRIx64 " %s %016" PRIx64 "\n", key, file.first.c_str(), file.second);
+    }
+    std::fclose(out);
+}
+
+std::uint64_t ResultCache::data_checksum(int func_id, int dim) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = checksums_.find({func_id, dim});
+    if (it != checksums_.end()) return it->second;
+    // Los mismos nombres que abre cec17_test_func.c
+    std::string f = std::to_string(func_id), d = std::to_string(dim);
+    fs::path data = "input_data";
+    ResultKey key;
+    add_file(key, data / ("M_" + f + "_D" + d + ".txt"));
+    add_file(key, data / ("shift_data_" + f + ".txt"));
+    add_file(key, data / ("shuffle_data_" + f + "_D" + d + ".txt"));
+    return checksums_[{func_id, dim}] = key.value();
+}
@@ -0,0 +1,85 @@
+// result_cache.h
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Clave de un trabajo del barrido: FNV-1a de 64 bits de todo lo que
+// determina su resultado (versión del algoritmo, parámetros, función,
+// dimensión, semilla y datos del evaluador). Los valores se añaden campo
+// a campo, nunca structs enteros, para que el relleno no cuente.
+class ResultKey {
+public:
+    template <class T>
+    ResultKey& add(const T& value) {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "solo valores escalares");
+        add_bytes(&value, sizeof(T));
+        return *this;
+    }
+
+    ResultKey& add(const std::string& text) {
+        add(text.size());
+        add_bytes(text.data(), text.size());
+        return *this;
+    }
+    ResultKey& add(const char* text) { return add(std::string(text)); }
+    void add_bytes(const void* data, std::size_t size);
+
+    std::uint64_t value() const { return hash_; }
+
+private:
+    std::uint64_t hash_ = 0xcbf29ce484222325ULL;
+};
+
+// Caché de resultados direccionada por contenido. Cada trabajo terminado
+// guarda una copia de todos sus ficheros (resultados, registro binario,
+// trazas, mejor posición, instantáneas) en cache/<clave>/ dentro de su
+// directorio de resultados, y el manifiesto (manifest.txt, una línea
+// "clave fichero suma" por fichero guardado; manda la última) dice qué
+// ficheros tiene cada clave y la suma (FNV-1a) de su contenido.
+//
+// Un trabajo se omite si su clave tiene guardados todos los ficheros que
+// pide; los que falten o sean de otra clave en el directorio se restauran
+// desde la copia. Así, volver a una configuración anterior no la repite.
+//
+// Las consultas, desde el hilo principal al encolar; record desde
+// cualquier hilo al terminar cada trabajo.
+class ResultCache {
+public:
+    // ¿Tiene key guardados todos los ficheros files (nombres dentro de dir)?
+    bool stored(const std::string& dir, std::uint64_t key, const std::vector<std::string>& files);
+
+    // Copia a dir los ficheros de key que no coinciden con los guardados;
+    // devuelve cuántos ha copiado. Solo tras stored.
+    int restore(const std::string& dir, std::uint64_t key, const std::vector<std::string>& files);
+
+    // ¿Es dir/file, tal como está, un fichero guardado por alguna clave?
+    // Entonces se puede sustituir sin perderlo.
+    bool known(const std::string& dir, const std::string& file);
+
+    // Guarda en la caché los ficheros de dir de un trabajo terminado con
+    // clave key (los que no existen no cuentan) y los apunta en el manifiesto
+    void record(const std::string& dir, std::uint64_t key, const std::vector<std::string>& files);
+
+    // Suma de los ficheros de input_data que lee el evaluador para
+    // (función, dimensión): matriz de rotación, desplazamiento y permutación
+    std::uint64_t data_checksum(int func_id, int dim);
+
+private:
+    // clave -> fichero -> suma de su contenido
+    using Manifest = std::map<std::uint64_t, std::map<std::string, std::uint64_t>>;
+    Manifest& manifest(const std::string& dir);
+
+    std::mutex mutex_;
+    std::map<std::string, Manifest> manifests_;   // por directorio
+    std::map<std::pair<int, int>, std::uint64_t> checksums_;
+};
+
+#endif // RESULT_CACHE_H
@@ -0,0 +1,158 @@
+// rng.cpp
+#include "rng.h"
+#include <cmath>
+
+namespace {
+
+constexpr std::uint32_t PHILOX_M0 = 0xD2511F53u;
+constexpr std::uint32_t PHILOX_M1 = 0xCD9E8D57u;
+constexpr std::uint32_t PHILOX_W0 = 0x9E3779B9u;
+constexpr std::uint32_t PHILOX_W1 = 0xBB67AE85u;
+constexpr int PHILOX_ROUNDS = 10;
+
+// Bloques que se calculan a la vez (un carril SIMD por bloque)
+constexpr int PHILOX_LANES = 8;
+
+constexpr double RNG_TWO_PI = 6.283185307179586476925286766559;
+
+inline std::uint64_t mix64(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+inline double to_unit(std::uint32_t hi, std::uint32_t lo) {
+    std::uint64_t x = (static_cast<std::uint64_t>(hi) << 32) | lo;
+    return static_cast<double>(x >> 11) * 0x1.0p-53;
+}
+
+// Philox4x32-10 sobre L contadores consecutivos
+template <int L>
+void philox_lanes(std::uint64_t seed, std::uint64_t stream, std::uint64_t counter,
+                  std::uint32_t c0[L], std::uint32_t c1[L],
+                  std::uint32_t c2[L], std::uint32_t c3[L]) {
+    for (int l = 0; l < L; ++l) {
+        std::uint64_t ctr = counter + l;
+        c0[l] = static_cast<std::uint32_t>(ctr);
+        c1[l] = static_cast<std::uint32_t>(ctr >> 32);
+        c2[l] = static_cast<std::uint32_t>(stream);
+        c3[l] = static_cast<std::uint32_t>(stream >> 32);
+    }
+    std::uint32_t k0 = static_cast<std::uint32_t>(seed);
+    std::uint32_t k1 = static_cast<std::uint32_t>(seed >> 32);
+    for (int r = 0; r < PHILOX_ROUNDS; ++r) {
+        for (int l = 0; l < L; ++l) {
+            std::uint64_t p0 = static_cast<std::uint64_t>(PHILOX_M0) * c0[l];
+            std::uint64_t p1 = static_cast<std::uint64_t>(PHILOX_M1) * c2[l];
+            std::uint32_t n0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1[l] ^ k0;
+            std::uint32_t n2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3[l] ^ k1;
+            c1[l] = static_cast<std::uint32_t>(p1);
+            c3[l] = static_cast<std::uint32_t>(p0);
+            c0[l] = n0;
+            c2[l] = n2;
+        }
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+}
+
+} // namespace
+
+std::uint64_t derive_seed(std::uint64_t seed, std::uint64_t run) {
+    if (run == 0) return seed;
+    std::uint64_t s = mix64(seed ^ mix64(run));
+    return s ? s : 1;   // 0 significa semilla aleatoria
+}
+
+Rng::Rng(std::uint64_t seed, std::uint64_t stream) : seed_(seed), stream_(stream) {}
+
+Rng Rng::split(std::uint64_t id) const {
+    return Rng(seed_, mix64(stream_ ^ mix64(id)));
+}
+
+Rng::State Rng::state() const {
+    return State{seed_, stream_, counter_, cached_, spare_normal_, has_cached_, has_spare_normal_};
+}
+
+void Rng::restore(const State& state) {
+    seed_ = state.seed;
+    stream_ = state.stream;
+    counter_ = state.counter;
+    cached_ = state.cached;
+    spare_normal_ = state.spare_normal;
+    has_cached_ = state.has_cached;
+    has_spare_normal_ = state.has_spare_normal;
+}
+
+void Rng::next_block(std::uint32_t out[4]) {
+    philox_lanes<1>(seed_, stream_, counter_++, &out[0], &out[1], &out[2], &out[3]);
+}
+
+double Rng::uniform() {
+    if (has_cached_) {
+        has_cached_ = false;
+        return cached_;
+    }
+    std::uint32_t b[4];
+    next_block(b);
+    cached_ = to_unit(b[2], b[3]);
+    has_cached_ = true;
+    return to_unit(b[0], b[1]);
+}
+
+int Rng::uniform_int(int lo, int hi) {
+    int v = lo + static_cast<int>(uniform() * (static_cast<double>(hi) - lo + 1));
+    return v > hi ? hi : v;
+}
+
+double Rng::normal(double mean, double sd) {
+    if (has_spare_normal_) {
+        has_spare_normal_ = false;
+        return mean + sd * spare_normal_;
+    }
+    double r = std::sqrt(-2.0 * std::log(1.0 - uniform()));
+    double th = RNG_TWO_PI * uniform();
+    spare_normal_ = r * std::sin(th);
+    has_spare_normal_ = true;
+    return mean + sd * r * std::cos(th);
+}
+
+// Cada bloque da dos uniformes, en el mismo orden que llamadas sucesivas a
+// uniform() empezando sin uniforme guardado
+void Rng::fill_uniform(double* out, std::size_t n) {
+    has_cached_ = false;
+    std::uint32_t c0[PHILOX_LANES], c1[PHILOX_LANES], c2[PHILOX_LANES], c3[PHILOX_LANES];
+    std::size_t i = 0;
+    while (i < n) {
+        philox_lanes<PHILOX_LANES>(seed_, stream_, counter_, c0, c1, c2, c3);
+        std::size_t blocks = (n - i + 1) / 2;
+        if (blocks > PHILOX_LANES) blocks = PHILOX_LANES;
+        counter_ += blocks;
+        if (i + 2 * PHILOX_LANES <= n) {
+            for (int l = 0; l < PHILOX_LANES; ++l) {
+                out[i + 2 * l]     = to_unit(c0[l], c1[l]);
+                out[i + 2 * l + 1] = to_unit(c2[l], c3[l]);
+            }
+            i += 2 * PHILOX_LANES;
+        } else {
+            for (std::size_t l = 0; l < blocks; ++l) {
+                out[i++] = to_unit(c0[l], c1[l]);
+                if (i < n) out[i++] = to_unit(c2[l], c3[l]);
+            }
+        }
+    }
+}
+
+void Rng::fill_normal(double* out, std::size_t n) {
+    has_spare_normal_ = false;
+    std::size_t even = n & ~static_cast<std::size_t>(1);
+    fill_uniform(out, even);
+    for (std::size_t i = 0; i < even; i += 2) {
+        double r = std::sqrt(-2.0 * std::log(1.0 - out[i]));
+        double th = RNG_TWO_PI * out[i + 1];
+        out[i] = r * std::cos(th);
+        out[i + 1] = r * std::sin(th);
+    }
+    if (even < n) out[even] = normal();
+}
@@ -0,0 +1,56 @@
+// rng.h
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Generador basado en contador (Philox4x32-10).
+// Cada número depende solo de (semilla, flujo, contador), así que:
+//  - una ejecución es reproducible a partir de su semilla,
+//  - split(id) da subflujos independientes (por luciérnaga, por hilo...),
+//  - fill_uniform/fill_normal rellenan bloques enteros de golpe, con un
+//    bucle por carriles que el compilador vectoriza.
+class Rng {
+public:
+    explicit Rng(std::uint64_t seed = 0, std::uint64_t stream = 0);
+
+    // Subflujo independiente con la misma semilla
+    Rng split(std::uint64_t id) const;
+
+    std::uint64_t seed() const { return seed_; }
+
+    double uniform();                         // [0, 1)
+    double uniform(double lo, double hi) { return lo + (hi - lo) * uniform(); }
+    int uniform_int(int lo, int hi);          // [lo, hi]
+    double normal(double mean = 0.0, double sd = 1.0);
+
+    void fill_uniform(double* out, std::size_t n);  // [0, 1)
+    void fill_normal(double* out, std::size_t n);   // N(0, 1)
+
+    // Estado completo, para guardar una ejecución y reanudarla igual
+    struct State {
+        std::uint64_t seed, stream, counter;
+        double cached, spare_normal;
+        bool has_cached, has_spare_normal;
+    };
+    State state() const;
+    void restore(const State& state);
+
+private:
+    void next_block(std::uint32_t out[4]);
+
+    std::uint64_t seed_;
+    std::uint64_t stream_;
+    std::uint64_t counter_ = 0;   // bloques de 128 bits consumidos
+    double cached_ = 0.0;         // segundo uniforme del último bloque
+    bool has_cached_ = false;
+    double spare_normal_ = 0.0;
+    bool has_spare_normal_ = false;
+};
+
+// Semilla de la ejecución run a partir de la de la configuración. La
+// ejecución 0 conserva la semilla; las demás la mezclan con su número.
+std::uint64_t derive_seed(std::uint64_t seed, std::uint64_t run);
+
+#endif // RNG_H
@@ -0,0 +1,65 @@
+// run_record.cpp
+#include "run_record.h"
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+
+static const std::uint32_t RUN_RECORD_MAGIC = 0x42524646;   // "FFRB"
+static const std::uint32_t RUN_RECORD_VERSION = 1;
+
+namespace {
+
+struct RunRecordHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t record_size;
+    std::uint32_t reserved;
+};
+
+} // namespace
+
+bool append_run_record(const std::string& path, const RunRecord& record) {
+    // Las repeticiones de una configuración comparten fichero y terminan a
+    // la vez: sin el cerrojo dos podrían verlo vacío y escribir dos cabeceras
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    FILE* out = std::fopen(path.c_str(), "ab");
+    if (out == nullptr) {
+        std::cerr << "Error: no se puede escribir " << path << "\n";
+        return false;
+    }
+    bool ok = true;
+    // En modo "ab" la posición inicial es el final: 0 si el fichero es nuevo
+    std::fseek(out, 0, SEEK_END);
+    if (std::ftell(out) == 0) {
+        RunRecordHeader header{RUN_RECORD_MAGIC, RUN_RECORD_VERSION, sizeof(RunRecord), 0};
+        ok = std::fwrite(&header, sizeof(header), 1, out) == 1;
+    }
+    ok = ok && std::fwrite(&record, sizeof(record), 1, out) == 1;
+    ok = std::fclose(out) == 0 && ok;
+    if (!ok) std::cerr << "Error: no se puede escribir " << path << "\n";
+    return ok;
+}
+
+bool read_run_records(const std::string& path, std::vector<RunRecord>& records) {
+    FILE* in = std::fopen(path.c_str(), "rb");
+    if (in == nullptr) return false;
+    RunRecordHeader header{};
+    bool ok = std::fread(&header, sizeof(header), 1, in) == 1
+           && header.magic == RUN_RECORD_MAGIC && header.version == RUN_RECORD_VERSION
+           && header.record_size == sizeof(RunRecord);
+    if (ok) {
+        // Todo el fichero de una vez: los registros son contiguos
+        std::fseek(in, 0, SEEK_END);
+        long size = std::ftell(in) - (long)sizeof(header);
+        std::fseek(in, (long)sizeof(header), SEEK_SET);
+        std::size_t n = size > 0 ? (std::size_t)size / sizeof(RunRecord) : 0;
+        std::size_t first = records.size();
+        records.resize(first + n);
+        std::size_t got = n ? std::fread(&records[first], sizeof(RunRecord), n, in) : 0;
+        records.resize(first + got);
+        ok = got == n && (std::size_t)size == n * sizeof(RunRecord);
+    }
+    std::fclose(in);
+    return ok;
+}
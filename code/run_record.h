@@ -0,0 +1,38 @@
+// run_record.h
+#ifndef RUN_RECORD_H
+#define RUN_RECORD_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Resultados binarios: alternativa a los results_F_D.txt para agregar muchas
+// ejecuciones sin parsear texto. Cada fichero (results_F_D.bin) empieza con
+// una cabecera y sigue con un registro de tamaño fijo por ejecución, que se
+// añade de una vez al terminarla; así el fichero solo crece y una ejecución
+// cortada no deja registros a medias.
+//
+// Cabecera: "FFRB", versión (u32), tamaño del registro (u32), reservado (u32).
+// Todo en el orden de bytes de la máquina.
+struct RunRecord {
+    static const int MILESTONES = 14;
+
+    std::int32_t func_id;
+    std::int32_t dim;
+    std::uint64_t seed;
+    std::int64_t max_fes;
+    std::int32_t milestones;                // los que hay en milestone/error
+    std::int32_t reserved;
+    std::int32_t milestone[MILESTONES];     // % del presupuesto, como en el .txt
+    double error[MILESTONES];               // mejor error en cada milestone
+};
+
+// Añade el registro, creando el fichero con su cabecera si no existe; se
+// puede llamar desde varios hilos a la vez sobre el mismo fichero
+bool append_run_record(const std::string& path, const RunRecord& record);
+
+// Añade a records los registros completos del fichero; false si no existe,
+// no es de este formato o acaba en un registro incompleto (que se ignora)
+bool read_run_records(const std::string& path, std::vector<RunRecord>& records);
+
+#endif // RUN_RECORD_H
@@ -0,0 +1,120 @@
+// soliswets.cpp
+#include "soliswets.h"
+#include <algorithm>
+
+static void clip(double* sol, int dim, double lower, double upper) {
+    for (int i = 0; i < dim; i++) {
+        if (sol[i] < lower) {
+            sol[i] = lower;
+        }
+        else if (sol[i] > upper) {
+            sol[i] = upper;
+        }
+    }
+}
+
+static void increm_bias(double* bias, const double* dif, int dim) {
+    for (int i = 0; i < dim; i++) {
+        bias[i] = 0.2*bias[i]+0.4*(dif[i]+bias[i]);
+    }
+}
+
+static void decrement_bias(double* bias, const double* dif, int dim) {
+    for (int i = 0; i < dim; i++) {
+        bias[i] = bias[i]-0.4*(dif[i]+bias[i]);
+    }
+}
+
+SolisWetsResult soliswets(double* sol, double& fitness, int dim, long long maxevals,
+                          const SolisWetsParams& params, Rng& rng,
+                          const SolisWetsBuffers& buf, const LsEvaluator& eval) {
+    double* bias = buf.bias;
+    double* dif = buf.dif;
+    double* plus = buf.newsol;
+    double* minus = buf.newsol + dim;
+    double delta = params.delta;
+    SolisWetsResult result;
+    long long& evals = result.evals;
+    int num_success = 0;
+    int num_failed = 0;
+
+    std::fill(bias, bias + dim, 0.0);
+
+    while (evals < maxevals) {
+        rng.fill_uniform(dif, dim);
+        for (int i = 0; i < dim; i++) {
+            dif[i] *= delta;
+            plus[i] = sol[i] + dif[i] + bias[i];
+        }
+        clip(plus, dim, params.lower, params.upper);
+
+        // Con batch_pair la sonda - se evalúa a la vez que la +, aunque
+        // luego no haga falta; sin él solo si la + no mejora
+        bool pair = params.batch_pair && evals + 2 <= maxevals;
+        double fplus, fminus = 0.0;
+        if (pair) {
+            for (int i = 0; i < dim; i++) {
+                minus[i] = sol[i] - dif[i] - bias[i];
+            }
+            clip(minus, dim, params.lower, params.upper);
+            if (eval.evaluate_pair) {
+                eval.evaluate_pair(eval.ctx, plus, minus, &fplus, &fminus);
+            } else {
+                fplus = eval.evaluate(eval.ctx, plus);
+                fminus = eval.evaluate(eval.ctx, minus);
+            }
+            evals += 2;
+        } else {
+            fplus = eval.evaluate(eval.ctx, plus);
+            evals += 1;
+        }
+
+        if (fplus < fitness) {
+            std::copy(plus, plus + dim, sol);
+            fitness = fplus;
+            increm_bias(bias, dif, dim);
+            num_success += 1;
+            num_failed = 0;
+            result.improvements += 1;
+        }
+        else if (pair || evals < maxevals) {
+            if (!pair) {
+                for (int i = 0; i < dim; i++) {
+                    minus[i] = sol[i] - dif[i] - bias[i];
+                }
+                clip(minus, dim, params.lower, params.upper);
+                fminus = eval.evaluate(eval.ctx, minus);
+                evals += 1;
+            }
+
+            if (fminus < fitness) {
+                std::copy(minus, minus + dim, sol);
+                fitness = fminus;
+                decrement_bias(bias, dif, dim);
+                num_success += 1;
+                num_failed = 0;
+                result.improvements += 1;
+            }
+            else {
+                for (int i = 0; i < dim; i++) {
+                    bias[i] /= 2;
+                }
+
+                num_success = 0;
+                num_failed += 1;
+            }
+        }
+
+        if (num_success >= 5) {
+            num_success = 0;
+            delta *= 2;
+        }
+        else if (num_failed >= 3) {
+            num_failed = 0;
+            delta /= 2;
+        }
+    }
+
+    result.delta = delta;
+    return result;
+}
@@ -0,0 +1,52 @@
+// soliswets.h
+#ifndef SOLISWETS_H
+#define SOLISWETS_H
+
+#include "rng.h"
+
+// Evaluación de soluciones para la búsqueda local.
+// evaluate_pair evalúa las dos soluciones de una vez (por ejemplo, en
+// paralelo); si es nulo se llama a evaluate dos veces.
+struct LsEvaluator {
+    double (*evaluate)(void* ctx, double* sol);
+    void (*evaluate_pair)(void* ctx, double* a, double* b, double* fa, double* fb);
+    void* ctx;
+};
+
+// Buffers de tamaño D que aporta quien llama (newsol, de tamaño 2*D)
+struct SolisWetsBuffers {
+    double* bias;
+    double* dif;
+    double* newsol;
+};
+
+struct SolisWetsParams {
+    double delta = 0.2;        // amplitud inicial de la perturbación
+    double lower = -100.0;
+    double upper = 100.0;
+    bool batch_pair = false;   // evaluar juntas las sondas + y -
+};
+
+struct SolisWetsResult {
+    long long evals = 0;       // evaluaciones consumidas
+    int improvements = 0;
+    double delta = 0.0;        // amplitud final
+};
+
+/**
+ * Aplica Solis-Wets sobre sol sin reservar memoria.
+ *
+ * @param sol solución a mejorar (se actualiza).
+ * @param fitness fitness de la solución (se actualiza).
+ * @param dim dimensión.
+ * @param maxevals evaluaciones como máximo.
+ * @param params parámetros.
+ * @param rng generador de la ejecución.
+ * @param buf buffers de trabajo.
+ * @param eval evaluador.
+ */
+SolisWetsResult soliswets(double* sol, double& fitness, int dim, long long maxevals,
+                          const SolisWetsParams& params, Rng& rng,
+                          const SolisWetsBuffers& buf, const LsEvaluator& eval);
+
+#endif // SOLISWETS_H
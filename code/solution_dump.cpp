@@ -0,0 +1,135 @@
+// solution_dump.cpp
+#include "solution_dump.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+static const std::uint32_t BEST_MAGIC = 0x50424646;    // "FFBP"
+static const std::uint32_t BEST_VERSION = 1;
+static const std::uint32_t SWARM_MAGIC = 0x57534646;   // "FFSW"
+static const std::uint32_t SWARM_VERSION = 1;
+
+// Bytes como mucho de una coordenada y de la cabecera de una instantánea
+static const std::size_t VARINT16_MAX = 3;
+static const std::size_t FRAME_HEADER = 2 * sizeof(long long) + sizeof(int);
+
+bool write_best_position(const std::string& path, int func_id, int dim, unsigned long long seed,
+                         long long fes, double fitness, const double* position) {
+    FILE* out = std::fopen(path.c_str(), "wb");
+    if (out == nullptr) {
+        std::cerr << "Error: no se puede escribir " << path << "\n";
+        return false;
+    }
+    double error = fitness - 100.0 * func_id;
+    std::fwrite(&BEST_MAGIC, sizeof(BEST_MAGIC), 1, out);
+    std::fwrite(&BEST_VERSION, sizeof(BEST_VERSION), 1, out);
+    std::fwrite(&func_id, sizeof(func_id), 1, out);
+    std::fwrite(&dim, sizeof(dim), 1, out);
+    std::fwrite(&seed, sizeof(seed), 1, out);
+    std::fwrite(&fes, sizeof(fes), 1, out);
+    std::fwrite(&fitness, sizeof(fitness), 1, out);
+    std::fwrite(&error, sizeof(error), 1, out);
+    std::fwrite(position, sizeof(double), (std::size_t)dim, out);
+    return std::fclose(out) == 0;
+}
+
+SwarmDump::SwarmDump(SnapshotEncoding encoding, int dim, double lower, double upper,
+                     std::size_t budget, int max_swarm)
+    : encoding_(encoding), dim_(dim), lower_(lower), upper_(upper), buf_(budget) {
+    if (encoding_ == SnapshotEncoding::DELTA16) {
+        prev_.resize((std::size_t)max_swarm * dim);
+        next_.resize((std::size_t)max_swarm * dim);
+    }
+}
+
+void SwarmDump::put_varint(std::uint32_t value) {
+    while (value >= 0x80) {
+        buf_[used_++] = static_cast<unsigned char>(value | 0x80);
+        value >>= 7;
+    }
+    buf_[used_++] = static_cast<unsigned char>(value);
+}
+
+bool SwarmDump::begin_frame(long long generation, long long fes, int n) {
+    bool delta = encoding_ == SnapshotEncoding::DELTA16;
+    std::size_t per_coord = delta ? VARINT16_MAX : sizeof(float);
+    std::size_t worst = FRAME_HEADER + (std::size_t)n * sizeof(double)
+                      + (std::size_t)n * dim_ * per_coord;
+    if (buf_.size() - used_ < worst || (delta && (std::size_t)n * dim_ > prev_.size())) {
+        ++dropped_;
+        return false;
+    }
+    key_ = frames_ == 0 || n != prev_n_;
+    put_raw(generation);
+    put_raw(fes);
+    put_raw(n);
+    return true;
+}
+
+void SwarmDump::put_position(int i, const double* x) {
+    if (encoding_ == SnapshotEncoding::FLOAT32) {
+        for (int k = 0; k < dim_; ++k) put_raw(static_cast<float>(x[k]));
+        return;
+    }
+    const double scale = 65535.0 / (upper_ - lower_);
+    std::uint16_t* codes = &next_[(std::size_t)i * dim_];
+    const std::uint16_t* prev = &prev_[(std::size_t)i * dim_];
+    for (int k = 0; k < dim_; ++k) {
+        double t = std::min(65535.0, std::max(0.0, (x[k] - lower_) * scale));
+        codes[k] = static_cast<std::uint16_t>(std::lround(t));
+        if (key_) {
+            put_varint(codes[k]);
+        } else {
+            // Diferencia entre códigos: exacta, el error no se acumula
+            std::int32_t d = (std::int32_t)codes[k] - (std::int32_t)prev[k];
+            put_varint(((std::uint32_t)d << 1) ^ (std::uint32_t)(d >> 31));
+        }
+    }
+}
+
+void SwarmDump::end_frame(int n) {
+    if (encoding_ == SnapshotEncoding::DELTA16) std::swap(prev_, next_);
+    prev_n_ = n;
+    ++frames_;
+}
+
+bool SwarmDump::write(const std::string& path, int func_id, unsigned long long seed) const {
+    FILE* out = std::fopen(path.c_str(), "wb");
+    if (out == nullptr) {
+        std::cerr << "Error: no se puede escribir " << path << "\n";
+        return false;
+    }
+    std::uint32_t encoding = static_cast<std::uint32_t>(encoding_);
+    std::fwrite(&SWARM_MAGIC, sizeof(SWARM_MAGIC), 1, out);
+    std::fwrite(&SWARM_VERSION, sizeof(SWARM_VERSION), 1, out);
+    std::fwrite(&encoding, sizeof(encoding), 1, out);
+    std::fwrite(&func_id, sizeof(func_id), 1, out);
+    std::fwrite(&dim_, sizeof(dim_), 1, out);
+    std::fwrite(&seed, sizeof(seed), 1, out);
+    std::fwrite(&lower_, sizeof(lower_), 1, out);
+    std::fwrite(&upper_, sizeof(upper_), 1, out);
+    std::fwrite(&frames_, sizeof(frames_), 1, out);
+    std::fwrite(&dropped_, sizeof(dropped_), 1, out);
+    std::fwrite(buf_.data(), 1, used_, out);
+    return std::fclose(out) == 0;
+}
+
+void SwarmDump::save(CheckpointWriter& out) const {
+    out.put(used_);
+    out.put_array(buf_.data(), used_);
+    out.put_array(prev_.data(), prev_.size());
+    out.put(prev_n_);
+    out.put(frames_);
+    out.put(dropped_);
+}
+
+void SwarmDump::restore(CheckpointReader& in) {
+    used_ = in.get<std::size_t>();
+    if (used_ > buf_.size()) buf_.resize(used_);   // guardado con un tope mayor
+    in.get_array(buf_.data(), used_);
+    in.get_array(prev_.data(), prev_.size());
+    prev_n_ = in.get<int>();
+    frames_ = in.get<long long>();
+    dropped_ = in.get<long long>();
+}
@@ -0,0 +1,82 @@
+// solution_dump.h
+#ifndef SOLUTION_DUMP_H
+#define SOLUTION_DUMP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "checkpoint.h"
+
+// Posiciones de una ejecución en binario (del mismo orden de bytes que la
+// máquina), para analizarlas después o empezar otra desde ellas.
+
+// Mejor posición: "FFBP", versión (u32), función, dimensión (i32), semilla
+// (u64), FEs (i64), fitness y error (f64), y las D coordenadas (f64)
+bool write_best_position(const std::string& path, int func_id, int dim, unsigned long long seed,
+                         long long fes, double fitness, const double* position);
+
+enum class SnapshotEncoding {
+    FLOAT32,   // coordenadas en float: 4 bytes, ~7 cifras
+    DELTA16    // coordenadas cuantizadas a 16 bits en [lower, upper] y guardadas
+               // como diferencia con la instantánea anterior (varint zigzag):
+               // 1-3 bytes, error máximo (upper-lower)/131070
+};
+
+// Instantáneas del enjambre cada K generaciones. Se codifican en un buffer
+// reservado al crearlo, con un tope de bytes, y el fichero se escribe de una
+// vez al terminar: guardar una instantánea no hace E/S ni reserva memoria,
+// y la que no cabe se descarta y se cuenta.
+//
+// Fichero: "FFSW", versión, codificación (u32), función, dimensión (i32),
+// semilla (u64), lower, upper (f64), instantáneas, descartadas (i64) y cada
+// instantánea: generación, FEs (i64), N (i32), y sus N fitness (f64) y N x D
+// coordenadas. Con DELTA16 la primera, y toda la que cambia de N, lleva los
+// códigos en lugar de las diferencias.
+class SwarmDump {
+public:
+    SwarmDump(SnapshotEncoding encoding, int dim, double lower, double upper,
+              std::size_t budget, int max_swarm);
+
+    // Una instantánea de n luciérnagas; position(i) y fitness(i) las leen
+    template <class P, class F>
+    void add(long long generation, long long fes, int n, P&& position, F&& fitness) {
+        if (!begin_frame(generation, fes, n)) return;
+        for (int i = 0; i < n; ++i) put_raw(fitness(i));
+        for (int i = 0; i < n; ++i) put_position(i, position(i));
+        end_frame(n);
+    }
+
+    bool write(const std::string& path, int func_id, unsigned long long seed) const;
+
+    // Estado para los checkpoints
+    void save(CheckpointWriter& out) const;
+    void restore(CheckpointReader& in);
+
+private:
+    bool begin_frame(long long generation, long long fes, int n);
+    void put_position(int i, const double* x);
+    void end_frame(int n);
+    template <class T>
+    void put_raw(const T& value) {
+        std::memcpy(&buf_[used_], &value, sizeof(T));
+        used_ += sizeof(T);
+    }
+    void put_varint(std::uint32_t value);
+
+    SnapshotEncoding encoding_;
+    int dim_;
+    double lower_;
+    double upper_;
+    std::vector<unsigned char> buf_;   // capacidad = tope
+    std::size_t used_ = 0;
+    std::vector<std::uint16_t> prev_;  // códigos de la instantánea anterior
+    std::vector<std::uint16_t> next_;
+    int prev_n_ = 0;
+    bool key_ = true;                  // la instantánea actual es absoluta
+    long long frames_ = 0;
+    long long dropped_ = 0;
+};
+
+#endif // SOLUTION_DUMP_H
@@ -0,0 +1,73 @@
+// termination.h
+#ifndef TERMINATION_H
+#define TERMINATION_H
+
+// Lo que ve una política de parada al final de cada iteración
+struct TerminationState {
+    long long fes;            // evaluaciones contabilizadas
+    long long stagnant_fes;   // evaluaciones desde la última mejora del mejor
+    double error;             // error del mejor (fitness - óptimo)
+    double seconds;           // tiempo de reloj desde el inicio de la ejecución
+    double diversity;         // diversidad del algoritmo; NaN si no la mide
+};
+
+// Criterio de parada anticipada, además del presupuesto de evaluaciones.
+// Al parar, el motor completa los milestones que faltan con el error del
+// mejor (cec17_finish), así que los ficheros de resultados siguen valiendo.
+class TerminationPolicy {
+public:
+    virtual ~TerminationPolicy() = default;
+
+    virtual const char* name() const = 0;
+    virtual bool done(const TerminationState& state) const = 0;
+
+    // ¿Necesita que el algoritmo mida la diversidad?
+    virtual bool uses_diversity() const { return false; }
+};
+
+// Error del mejor por debajo del umbral de éxito del CEC
+class TargetError : public TerminationPolicy {
+public:
+    explicit TargetError(double target = 1e-8) : target_(target) {}
+    const char* name() const override { return "error objetivo"; }
+    bool done(const TerminationState& state) const override { return state.error < target_; }
+
+private:
+    double target_;
+};
+
+// Sin mejorar el mejor durante fes evaluaciones
+class Stagnation : public TerminationPolicy {
+public:
+    explicit Stagnation(long long fes) : fes_(fes) {}
+    const char* name() const override { return "estancamiento"; }
+    bool done(const TerminationState& state) const override { return state.stagnant_fes >= fes_; }
+
+private:
+    long long fes_;
+};
+
+// Población colapsada: diversidad por debajo de epsilon
+class DiversityCollapse : public TerminationPolicy {
+public:
+    explicit DiversityCollapse(double epsilon) : epsilon_(epsilon) {}
+    const char* name() const override { return "diversidad"; }
+    bool done(const TerminationState& state) const override { return state.diversity < epsilon_; }
+    bool uses_diversity() const override { return true; }
+
+private:
+    double epsilon_;
+};
+
+// Tiempo de reloj máximo por ejecución
+class Deadline : public TerminationPolicy {
+public:
+    explicit Deadline(double seconds) : seconds_(seconds) {}
+    const char* name() const override { return "tiempo límite"; }
+    bool done(const TerminationState& state) const override { return state.seconds >= seconds_; }
+
+private:
+    double seconds_;
+};
+
+#endif // TERMINATION_H
@@ -1,45 +1,25 @@
-extern "C" {
-#include "cec17.h"
-}
 #include <iostream>
-#include <vector>
-#include <random>
+#include "cec17.h"
+#include "engine.h"
+#include "random_search.h"
 
 using namespace std;
 
 int main() {
-  vector<double> sol;
   int dim = 10;
   int seed = 42;
-  std::uniform_real_distribution<> dis(-100.0, 100.0);
 
   for (int funcid = 1; funcid <= 30; funcid++) {
-    vector<double> sol(dim);
-    vector<double> bestsol(dim);
-    double fitness;
-    double best = -1;
-
-    cec17_init("random", funcid, dim);
-
-    cerr <<"Warning: output by console, if you want to create the output file you have to comment cec17_print_output()" <<endl;
-    cec17_print_output(); // Comment to generate the output file
-
-    std::mt19937 gen(seed); // Inicio semilla
-    int evals = 0;
-
-    while (evals < 10000*dim) {
-      for (int i = 0; i < dim; i++) {
-        sol[i] = dis(gen);
-      }
+    EngineConfig config{dim, funcid, "random", 10000LL*dim};
+    config.seed = seed;
+    config.verbose = false;
 
-      fitness = cec17_fitness(&sol[0]);
-      evals += 1;
+    cerr <<"Warning: output by console, if you want to create the output file you have to set print_output to false" <<endl;
+    config.print_output = true; // false para generar el fichero de salida
 
-      if (evals == 1 || fitness < best) {
-        best = fitness;
-        bestsol = sol;
-      }
-    }
+    Engine engine(config);
+    RandomSearch random;
+    double best = engine.run(random);
 
     cout <<"Best Random[F" <<funcid <<"]: " << scientific <<cec17_error(best) <<endl;
   }
@@ -0,0 +1,28 @@
+// tests/check.h
+#ifndef TESTS_CHECK_H
+#define TESTS_CHECK_H
+
+#include <cstdio>
+#include <cstdlib>
+
+// Comprobaciones de las pruebas: cada fallo se muestra con su línea y
+// sigue; check_result da el código de salida para ctest
+static int check_failures = 0;
+
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        if (!(cond)) {                                                        \
+            std::fprintf(stderr, "%s:%d: falla %s\n", __FILE__, __LINE__, #cond); \
+            ++check_failures;                                                 \
+        }                                                                     \
+    } while (0)
+
+inline int check_result() {
+    if (check_failures > 0) {
+        std::fprintf(stderr, "%d comprobaciones fallidas\n", check_failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+#endif // TESTS_CHECK_H
@@ -0,0 +1,41 @@
+// tests/test_cec17_context.cpp
+// Fichero de milestones de un contexto cec17 con los nombres de algoritmo
+// que forma main (más de 30 caracteres): la ruta no se corta y los
+// milestones llegan al directorio results_<alg> completo
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include "cec17.h"
+#include "check.h"
+
+namespace fs = std::filesystem;
+
+static const int FUNC = 2, DIM = 10;
+
+int main() {
+    const std::string names[] = {"MyFireflyD10_local_search",
+                                 "MyFireflyD10_local_search_isl4_async_stopdiv"};
+    for (const std::string& name : names) {
+        const fs::path dir = "results_" + name;
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+
+        cec17_context* ctx = cec17_context_new();
+        CHECK(ctx != nullptr);
+        cec17_init_r(ctx, name.c_str(), FUNC, DIM);
+        const std::string expected = (dir / ("results_" + std::to_string(FUNC) + "_" + std::to_string(DIM) + ".txt")).string();
+        CHECK(cec17_output_file_r(ctx) == expected);
+
+        // Todo el presupuesto sin evaluar: 14 milestones y la cabecera
+        for (int i = 0; i < 10000 * DIM; ++i) cec17_register_r(ctx, 100.0 * FUNC + 1.0);
+        cec17_context_free(ctx);
+
+        std::ifstream in(expected);
+        std::string line;
+        int lines = 0;
+        while (std::getline(in, line)) ++lines;
+        CHECK(lines == 15);
+        fs::remove_all(dir);
+    }
+    return check_result();
+}
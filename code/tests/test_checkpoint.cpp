@@ -0,0 +1,95 @@
+// tests/test_checkpoint.cpp
+// Ida y vuelta de CheckpointWriter/CheckpointReader, y rechazo de los
+// ficheros truncados, alterados o que no existen
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include "checkpoint.h"
+#include "check.h"
+
+namespace fs = std::filesystem;
+
+static const char* PATH = "checkpoint_test.bin";
+
+struct Pair {
+    int a;
+    double b;
+};
+
+static void write_sample() {
+    CheckpointWriter out;
+    const double values[3] = {1.5, -2.25, 1e300};
+    out.put(std::uint32_t(0x4B434646));
+    out.put(42LL);
+    out.put(Pair{7, 0.125});
+    out.put_array(values, 3);
+    out.put(true);
+    CHECK(out.save(PATH));
+}
+
+// Da la vuelta a un byte del fichero
+static void flip_byte(std::uintmax_t offset) {
+    std::fstream f(PATH, std::ios::in | std::ios::out | std::ios::binary);
+    f.seekg((std::streamoff)offset);
+    char c = 0;
+    f.read(&c, 1);
+    c ^= 0x20;
+    f.seekp((std::streamoff)offset);
+    f.write(&c, 1);
+}
+
+int main() {
+    write_sample();
+    CHECK(!fs::exists(std::string(PATH) + ".tmp"));
+
+    CheckpointReader in;
+    CHECK(in.load(PATH));
+    CHECK(in.ok());
+    CHECK(in.get<std::uint32_t>() == 0x4B434646);
+    CHECK(in.get<long long>() == 42);
+    Pair p = in.get<Pair>();
+    CHECK(p.a == 7 && p.b == 0.125);
+    double values[3] = {};
+    in.get_array(values, 3);
+    CHECK(values[0] == 1.5 && values[1] == -2.25 && values[2] == 1e300);
+    CHECK(in.get<bool>());
+    CHECK(in.at_end() && in.ok());
+
+    // Leer de más deja ok() en false y devuelve 0
+    CHECK(in.get<long long>() == 0);
+    CHECK(!in.ok());
+
+    // Un byte cambiado, en los datos o en la suma
+    auto size = fs::file_size(PATH);
+    flip_byte(5);
+    CHECK(!in.load(PATH) && !in.ok());
+    CHECK(in.get<std::uint32_t>() == 0);
+    write_sample();
+    flip_byte(size - 1);
+    CHECK(!in.load(PATH));
+
+    // Truncado: por el final y por debajo del tamaño de la suma
+    write_sample();
+    fs::resize_file(PATH, size - 3);
+    CHECK(!in.load(PATH));
+    fs::resize_file(PATH, 4);
+    CHECK(!in.load(PATH));
+
+    // Sin fichero
+    fs::remove(PATH);
+    CHECK(!in.load(PATH) && !in.ok());
+
+    // Guardar otra vez sustituye al anterior
+    CheckpointWriter out;
+    out.put(1);
+    CHECK(out.save(PATH));
+    out.clear();
+    out.put(2);
+    CHECK(out.save(PATH));
+    CHECK(in.load(PATH) && in.get<int>() == 2 && in.at_end());
+    fs::remove(PATH);
+
+    return check_result();
+}
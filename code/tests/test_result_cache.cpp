@@ -0,0 +1,99 @@
+// tests/test_result_cache.cpp
+// Clave de los trabajos (FNV-1a) y caché de resultados: lo que se guarda
+// con una clave se encuentra, se restaura igual aunque se haya borrado o
+// sustituido por el de otra clave, y el manifiesto se vuelve a leer igual
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "check.h"
+#include "result_cache.h"
+
+namespace fs = std::filesystem;
+
+static const std::string DIR = "results_cache_test";
+
+static void write_file(const std::string& name, const std::string& text) {
+    std::ofstream(fs::path(DIR) / name, std::ios::binary | std::ios::trunc) << text;
+}
+
+static std::string read_file(const std::string& name) {
+    std::ifstream in(fs::path(DIR) / name, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+int main() {
+    // FNV-1a de 64 bits: valores de referencia
+    CHECK(ResultKey().value() == 0xcbf29ce484222325ULL);
+    ResultKey a;
+    a.add_bytes("a", 1);
+    CHECK(a.value() == 0xaf63dc4c8601ec8cULL);
+    // Los textos llevan su longitud: ("ab", "c") no es ("a", "bc")
+    CHECK(ResultKey().add("ab").add("c").value() != ResultKey().add("a").add("bc").value());
+    CHECK(ResultKey().add(1).add(2.0).value() == ResultKey().add(1).add(2.0).value());
+    CHECK(ResultKey().add(1).value() != ResultKey().add(1LL).value());
+
+    fs::remove_all(DIR);
+    fs::create_directories(DIR);
+    const std::uint64_t KEY_A = 0x1111, KEY_B = 0x2222;
+    const std::vector<std::string> files{"results_1_10.txt", "best_1_10.bin"};
+
+    {
+        ResultCache cache;
+        CHECK(!cache.stored(DIR, KEY_A, files));
+        write_file(files[0], "funcid,dim,milestone,error\nA\n");
+        write_file(files[1], std::string("\0\1A", 3));
+        CHECK(!cache.known(DIR, files[0]));
+        cache.record(DIR, KEY_A, files);
+        CHECK(cache.stored(DIR, KEY_A, files));
+        CHECK(cache.known(DIR, files[0]));
+        CHECK(cache.restore(DIR, KEY_A, files) == 0);   // ya están
+        // Otra clave con los mismos nombres
+        write_file(files[0], "funcid,dim,milestone,error\nB\n");
+        write_file(files[1], std::string("\0\1B", 3));
+        CHECK(!cache.stored(DIR, KEY_B, files));
+        cache.record(DIR, KEY_B, files);
+    }
+
+    // Otra instancia lee el manifiesto del disco
+    ResultCache cache;
+    CHECK(cache.stored(DIR, KEY_A, files) && cache.stored(DIR, KEY_B, files));
+    CHECK(!cache.stored(DIR, KEY_A, {files[0], "trace_1_10.bin"}));   // fichero no guardado
+    CHECK(!cache.stored(DIR, 0x3333, {files[0]}));
+
+    // Volver a A: se restauran sus dos ficheros, y B sigue guardada
+    CHECK(cache.restore(DIR, KEY_A, files) == 2);
+    CHECK(read_file(files[0]) == "funcid,dim,milestone,error\nA\n");
+    CHECK(read_file(files[1]) == std::string("\0\1A", 3));
+    fs::remove(fs::path(DIR) / files[1]);
+    CHECK(cache.restore(DIR, KEY_A, files) == 1);
+    CHECK(read_file(files[1]) == std::string("\0\1A", 3));
+    CHECK(cache.restore(DIR, KEY_B, files) == 2);
+    CHECK(read_file(files[0]) == "funcid,dim,milestone,error\nB\n");
+
+    // Un resultado que no es de ninguna clave no se conoce
+    write_file(files[0], "funcid,dim,milestone,error\nC\n");
+    CHECK(!cache.known(DIR, files[0]));
+    CHECK(cache.known(DIR, files[1]));
+
+    // Si falta la copia guardada, la clave ya no vale
+    fs::remove_all(fs::path(DIR) / "cache" / "0000000000002222");
+    CHECK(!cache.stored(DIR, KEY_B, files));
+    CHECK(cache.stored(DIR, KEY_A, files));
+
+    // Las líneas del formato anterior ("clave fichero") no cuentan, y los
+    // ficheros que no existen al terminar no se guardan
+    {
+        std::ofstream(fs::path(DIR) / "manifest.txt", std::ios::app) << "0000000000004444 results_1_10.txt\n";
+        ResultCache reread;
+        CHECK(!reread.stored(DIR, 0x4444, {files[0]}));
+        reread.record(DIR, 0x5555, {files[0], "missing.bin"});
+        CHECK(reread.stored(DIR, 0x5555, {files[0]}));
+        CHECK(!reread.stored(DIR, 0x5555, {files[0], "missing.bin"}));
+    }
+
+    fs::remove_all(DIR);
+    return check_result();
+}
@@ -0,0 +1,100 @@
+// tests/test_run_record.cpp
+// Ida y vuelta de los registros binarios (run_record.h): se leen igual que
+// se añadieron, también desde varios hilos a la vez, y un registro cortado
+// al final o una cabecera ajena se detectan
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include "check.h"
+#include "run_record.h"
+
+namespace fs = std::filesystem;
+
+static const char* PATH = "run_record_test.bin";
+
+static RunRecord sample(int seed) {
+    RunRecord r;
+    std::memset(&r, 0, sizeof(r));   // también el relleno, para comparar bytes
+    r.func_id = 4;
+    r.dim = 30;
+    r.seed = 1000ULL + seed;
+    r.max_fes = 300000;
+    r.milestones = RunRecord::MILESTONES;
+    for (int i = 0; i < RunRecord::MILESTONES; ++i) {
+        r.milestone[i] = i + 1;
+        r.error[i] = 1e3 / (i + 1) + seed;
+    }
+    return r;
+}
+
+int main() {
+    fs::remove(PATH);
+    for (int s = 0; s < 3; ++s) CHECK(append_run_record(PATH, sample(s)));
+
+    std::vector<RunRecord> records;
+    CHECK(read_run_records(PATH, records));
+    CHECK(records.size() == 3);
+    for (int s = 0; s < 3 && s < (int)records.size(); ++s) {
+        RunRecord expected = sample(s);
+        CHECK(std::memcmp(&records[s], &expected, sizeof(RunRecord)) == 0);
+    }
+
+    // Se añaden a los que ya hay en el vector
+    CHECK(read_run_records(PATH, records));
+    CHECK(records.size() == 6);
+
+    // Varios hilos a la vez sobre un fichero nuevo, como las repeticiones
+    // de --runs N --binary: una sola cabecera y todos los registros enteros
+    for (int round = 0; round < 20; ++round) {
+        const std::string shared = "run_record_threads.bin";
+        fs::remove(shared);
+        const int THREADS = 8, EACH = 4;
+        std::atomic<int> ready{0};   // salen todos juntos hacia el fichero vacío
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t)
+            threads.emplace_back([&shared, &ready, t] {
+                ready.fetch_add(1);
+                while (ready.load() < THREADS) {
+                }
+                for (int k = 0; k < EACH; ++k) append_run_record(shared, sample(t * EACH + k));
+            });
+        for (auto& t : threads) t.join();
+        std::vector<RunRecord> all;
+        CHECK(read_run_records(shared, all));
+        CHECK(all.size() == (std::size_t)(THREADS * EACH));
+        std::vector<bool> seen(THREADS * EACH, false);
+        for (const RunRecord& r : all) {
+            int s = (int)(r.seed - 1000ULL);
+            RunRecord expected = sample(s);
+            CHECK(s >= 0 && s < THREADS * EACH && !seen[s]);
+            CHECK(std::memcmp(&r, &expected, sizeof(RunRecord)) == 0);
+            if (s >= 0 && s < THREADS * EACH) seen[s] = true;
+        }
+        fs::remove(shared);
+    }
+
+    // Un registro a medias al final: false, pero los completos se leen
+    {
+        std::ofstream out(PATH, std::ios::binary | std::ios::app);
+        out.write("parcial", 7);
+    }
+    records.clear();
+    CHECK(!read_run_records(PATH, records));
+    CHECK(records.size() == 3);
+
+    // Otro formato o sin fichero
+    {
+        std::ofstream out(PATH, std::ios::binary | std::ios::trunc);
+        out << "funcid,dim,milestone,error\n";
+    }
+    records.clear();
+    CHECK(!read_run_records(PATH, records) && records.empty());
+    fs::remove(PATH);
+    CHECK(!read_run_records(PATH, records) && records.empty());
+
+    return check_result();
+}
@@ -0,0 +1,212 @@
+// tests/test_solution_dump.cpp
+// Ida y vuelta de solution_dump.h: la mejor posición, y las instantáneas
+// del enjambre en float y en delta16 decodificadas según el formato
+// (cuantización, varint zigzag, instantáneas absolutas al cambiar N),
+// con tope de bytes y reanudadas desde un checkpoint
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "check.h"
+#include "solution_dump.h"
+
+namespace fs = std::filesystem;
+
+static const int DIM = 3;
+static const double LOWER = -100.0, UPPER = 100.0;
+
+static std::vector<char> read_all(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// Lector secuencial de un fichero leído entero
+struct Bytes {
+    std::vector<char> data;
+    std::size_t pos = 0;
+    bool ok = true;
+
+    template <class T>
+    T get() {
+        T value{};
+        if (data.size() - pos < sizeof(T)) {
+            ok = false;
+            return value;
+        }
+        std::memcpy(&value, data.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+    std::uint32_t varint() {
+        std::uint32_t value = 0;
+        for (int shift = 0; ok; shift += 7) {
+            auto byte = get<unsigned char>();
+            value |= (std::uint32_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) break;
+        }
+        return value;
+    }
+    bool at_end() const { return pos == data.size(); }
+};
+
+struct Frame {
+    long long generation, fes;
+    std::vector<double> fitness;
+    std::vector<double> position;   // n x DIM
+};
+
+struct SwarmFile {
+    std::uint32_t magic, version, encoding;
+    int func_id, dim;
+    unsigned long long seed;
+    double lower, upper;
+    long long frames, dropped;
+    std::vector<Frame> data;
+    bool ok;
+};
+
+static SwarmFile read_swarm(const std::string& path) {
+    Bytes in{read_all(path)};
+    SwarmFile s;
+    s.magic = in.get<std::uint32_t>();
+    s.version = in.get<std::uint32_t>();
+    s.encoding = in.get<std::uint32_t>();
+    s.func_id = in.get<int>();
+    s.dim = in.get<int>();
+    s.seed = in.get<unsigned long long>();
+    s.lower = in.get<double>();
+    s.upper = in.get<double>();
+    s.frames = in.get<long long>();
+    s.dropped = in.get<long long>();
+    bool delta = s.encoding == static_cast<std::uint32_t>(SnapshotEncoding::DELTA16);
+    std::vector<std::int32_t> codes;
+    int prev_n = -1;
+    for (long long f = 0; f < s.frames && in.ok && s.dim == DIM; ++f) {
+        Frame fr;
+        fr.generation = in.get<long long>();
+        fr.fes = in.get<long long>();
+        int n = in.get<int>();
+        if (n < 0 || n > 1000) break;
+        for (int i = 0; i < n; ++i) fr.fitness.push_back(in.get<double>());
+        bool key = n != prev_n;
+        codes.resize((std::size_t)n * DIM);
+        for (int k = 0; k < n * DIM; ++k) {
+            if (!delta) {
+                fr.position.push_back(in.get<float>());
+                continue;
+            }
+            std::uint32_t v = in.varint();
+            codes[k] = key ? (std::int32_t)v : codes[k] + (std::int32_t)((v >> 1) ^ (0u - (v & 1)));
+            fr.position.push_back(s.lower + codes[k] * (s.upper - s.lower) / 65535.0);
+        }
+        prev_n = n;
+        s.data.push_back(std::move(fr));
+    }
+    s.ok = in.ok && in.at_end() && (long long)s.data.size() == s.frames;
+    return s;
+}
+
+// Posición de la luciérnaga i en la generación g; incluye los extremos y
+// valores fuera de [LOWER, UPPER]
+static void position(int g, int i, double* x) {
+    for (int k = 0; k < DIM; ++k) x[k] = 95.0 * std::sin(1.3 * g + 2.1 * i + 0.7 * k);
+    if (g == 1 && i == 0) x[0] = LOWER, x[1] = UPPER, x[2] = 150.0;
+}
+
+static int swarm_size(int g) { return g < 2 ? 4 : 3; }
+
+static void add_frame(SwarmDump& dump, int g) {
+    std::vector<double> xs((std::size_t)swarm_size(g) * DIM);
+    for (int i = 0; i < swarm_size(g); ++i) position(g, i, &xs[(std::size_t)i * DIM]);
+    dump.add(g, 100LL * g, swarm_size(g), [&](int i) { return &xs[(std::size_t)i * DIM]; },
+             [&](int i) { return 1000.0 + g - 0.5 * i; });
+}
+
+static void check_swarm(const std::string& path, SnapshotEncoding encoding, int frames) {
+    SwarmFile s = read_swarm(path);
+    CHECK(s.ok);
+    CHECK(s.magic == 0x57534646 && s.version == 1);
+    CHECK(s.encoding == static_cast<std::uint32_t>(encoding));
+    CHECK(s.func_id == 9 && s.dim == DIM && s.seed == 123);
+    CHECK(s.lower == LOWER && s.upper == UPPER);
+    CHECK(s.frames == frames && s.dropped == 0);
+    // Error de cuantización: medio paso de 16 bits
+    const double tolerance = encoding == SnapshotEncoding::DELTA16 ? (UPPER - LOWER) / 131070 * (1 + 1e-9) : 0.0;
+    for (int g = 0; g < (int)s.data.size(); ++g) {
+        const Frame& fr = s.data[g];
+        CHECK(fr.generation == g && fr.fes == 100LL * g);
+        CHECK((int)fr.fitness.size() == swarm_size(g));
+        for (int i = 0; i < swarm_size(g) && i < (int)fr.fitness.size(); ++i) {
+            CHECK(fr.fitness[i] == 1000.0 + g - 0.5 * i);
+            double x[DIM];
+            position(g, i, x);
+            for (int k = 0; k < DIM; ++k) {
+                double got = fr.position[(std::size_t)i * DIM + k];
+                if (encoding == SnapshotEncoding::FLOAT32) {
+                    CHECK(got == (double)(float)x[k]);
+                } else {
+                    double clamped = std::min(UPPER, std::max(LOWER, x[k]));
+                    CHECK(std::fabs(got - clamped) <= tolerance);
+                }
+            }
+        }
+    }
+}
+
+int main() {
+    // Mejor posición
+    const double best[DIM] = {1.25, -99.5, 3e-7};
+    CHECK(write_best_position("best_test.bin", 7, DIM, 55, 1234, 712.5, best));
+    {
+        Bytes in{read_all("best_test.bin")};
+        CHECK(in.get<std::uint32_t>() == 0x50424646 && in.get<std::uint32_t>() == 1);
+        CHECK(in.get<int>() == 7 && in.get<int>() == DIM);
+        CHECK(in.get<unsigned long long>() == 55 && in.get<long long>() == 1234);
+        CHECK(in.get<double>() == 712.5 && in.get<double>() == 12.5);
+        for (int k = 0; k < DIM; ++k) CHECK(in.get<double>() == best[k]);
+        CHECK(in.ok && in.at_end());
+    }
+    fs::remove("best_test.bin");
+
+    // Enjambre: 4 instantáneas, la tercera cambia de N (vuelve a ser absoluta)
+    for (SnapshotEncoding encoding : {SnapshotEncoding::FLOAT32, SnapshotEncoding::DELTA16}) {
+        SwarmDump dump(encoding, DIM, LOWER, UPPER, 1 << 16, 4);
+        for (int g = 0; g < 4; ++g) add_frame(dump, g);
+        CHECK(dump.write("swarm_test.bin", 9, 123));
+        check_swarm("swarm_test.bin", encoding, 4);
+
+        // Cortado tras la 2ª y reanudado desde un checkpoint: los mismos bytes
+        SwarmDump first(encoding, DIM, LOWER, UPPER, 1 << 16, 4);
+        for (int g = 0; g < 2; ++g) add_frame(first, g);
+        CheckpointWriter out;
+        first.save(out);
+        CHECK(out.save("swarm_test.ck"));
+        CheckpointReader in;
+        CHECK(in.load("swarm_test.ck"));
+        SwarmDump resumed(encoding, DIM, LOWER, UPPER, 1 << 16, 4);
+        resumed.restore(in);
+        CHECK(in.ok() && in.at_end());
+        for (int g = 2; g < 4; ++g) add_frame(resumed, g);
+        CHECK(resumed.write("swarm_resumed.bin", 9, 123));
+        CHECK(read_all("swarm_resumed.bin") == read_all("swarm_test.bin"));
+
+        // Con un tope para una sola instantánea, las demás se descartan
+        SwarmDump small(encoding, DIM, LOWER, UPPER, 200, 4);
+        for (int g = 0; g < 4; ++g) add_frame(small, g);
+        CHECK(small.write("swarm_small.bin", 9, 123));
+        SwarmFile s = read_swarm("swarm_small.bin");
+        CHECK(s.ok && s.frames + s.dropped == 4 && s.frames >= 1 && s.dropped >= 1);
+    }
+    fs::remove("swarm_test.bin");
+    fs::remove("swarm_resumed.bin");
+    fs::remove("swarm_small.bin");
+    fs::remove("swarm_test.ck");
+
+    return check_result();
+}
@@ -0,0 +1,122 @@
+// tests/test_trace.cpp
+// Ida y vuelta de la traza de convergencia (trace.h): el fichero tiene las
+// mejoras que caben en el anillo y las muestras de la planificación, y una
+// traza restaurada de un checkpoint escribe lo mismo que la original
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "check.h"
+#include "trace.h"
+
+namespace fs = std::filesystem;
+
+static const int FUNC = 3;
+static const double OPTIMUM = 100.0 * FUNC;
+static const long long MAX_FES = 100;
+
+struct TracePoint {
+    long long fes;
+    double error;
+};
+
+struct TraceFile {
+    std::uint32_t magic = 0, version = 0;
+    int func_id = 0, dim = 0;
+    long long max_fes = 0;
+    unsigned long long seed = 0;
+    double optimum = 0;
+    long long kept = 0, dropped = 0, samples = 0;
+    std::vector<TracePoint> points;   // mejoras y luego muestras
+    bool ok = false;
+};
+
+static std::vector<char> read_all(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static TraceFile read_trace(const std::string& path) {
+    TraceFile t;
+    std::ifstream in(path, std::ios::binary);
+    auto get = [&](auto& value) { in.read(reinterpret_cast<char*>(&value), sizeof(value)); };
+    get(t.magic), get(t.version), get(t.func_id), get(t.dim), get(t.max_fes), get(t.seed);
+    get(t.optimum), get(t.kept), get(t.dropped), get(t.samples);
+    if (!in || t.kept + t.samples > 1000) return t;
+    t.points.resize((std::size_t)(t.kept + t.samples));
+    for (auto& p : t.points) get(p.fes), get(p.error);
+    t.ok = (bool)in && in.peek() == EOF;
+    return t;
+}
+
+// Mejora en 1, 3, 10, 30, 50 y 70; nada más
+static double fitness_at(long long fes) {
+    const long long at[] = {1, 3, 10, 30, 50, 70};
+    double best = 1e9;
+    for (long long f : at)
+        if (fes >= f) best = OPTIMUM + 1000.0 / f;
+    return best;
+}
+
+static void feed(TraceRecorder& trace, long long from, long long to, double& best) {
+    for (long long fes = from; fes <= to; ++fes) {
+        double fitness = fitness_at(fes);
+        bool improved = fitness < best;
+        if (improved) best = fitness;
+        trace.record(fes, improved ? fitness : 1e12, best, improved);
+    }
+}
+
+int main() {
+    TraceSchedule schedule = TraceSchedule::linear(5, MAX_FES);   // 20, 40, 60, 80, 100
+    CHECK(schedule.points() == (std::vector<long long>{20, 40, 60, 80, 100}));
+
+    TraceRecorder trace(4, schedule);
+    double best = 1e300;
+    feed(trace, 1, MAX_FES, best);
+    CHECK(trace.write("trace_test.bin", FUNC, 10, MAX_FES, 77));
+
+    TraceFile t = read_trace("trace_test.bin");
+    CHECK(t.ok);
+    CHECK(t.magic == 0x52544646 && t.version == 1);
+    CHECK(t.func_id == FUNC && t.dim == 10 && t.max_fes == MAX_FES && t.seed == 77);
+    CHECK(t.optimum == OPTIMUM);
+    // 6 mejoras en un anillo de 4: quedan las últimas, en orden
+    CHECK(t.kept == 4 && t.dropped == 2 && t.samples == 5);
+    if (t.ok) {
+        const long long improved[] = {10, 30, 50, 70};
+        for (int i = 0; i < 4; ++i) {
+            CHECK(t.points[i].fes == improved[i]);
+            CHECK(t.points[i].error == fitness_at(improved[i]) - OPTIMUM);
+        }
+        for (int i = 0; i < 5; ++i) {
+            long long fes = 20 * (i + 1);
+            CHECK(t.points[4 + i].fes == fes);
+            CHECK(t.points[4 + i].error == fitness_at(fes) - OPTIMUM);
+        }
+    }
+
+    // Cortada en 45 y reanudada desde su estado: el mismo fichero
+    TraceRecorder first(4, schedule);
+    double best_first = 1e300;
+    feed(first, 1, 45, best_first);
+    CheckpointWriter out;
+    first.save(out);
+    CHECK(out.save("trace_test.ck"));
+    CheckpointReader in;
+    CHECK(in.load("trace_test.ck"));
+    TraceRecorder resumed(4, schedule);
+    resumed.restore(in);
+    CHECK(in.ok() && in.at_end());
+    feed(resumed, 46, MAX_FES, best_first);
+    CHECK(resumed.write("trace_resumed.bin", FUNC, 10, MAX_FES, 77));
+    CHECK(read_all("trace_resumed.bin") == read_all("trace_test.bin"));
+
+    fs::remove("trace_test.bin");
+    fs::remove("trace_resumed.bin");
+    fs::remove("trace_test.ck");
+    return check_result();
+}
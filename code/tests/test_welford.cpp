@@ -0,0 +1,66 @@
+// tests/test_welford.cpp
+// Welford y su unión (Chan et al.), como los usa aggregate_results: la
+// media y la desviación de datos repartidos en trozos, unidos en cualquier
+// orden, coinciden con las de dos pasadas
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "check.h"
+#include "welford.h"
+
+static bool near(double a, double b, double rel) {
+    return std::fabs(a - b) <= rel * std::max(1.0, std::fabs(b));
+}
+
+int main() {
+    // Un desplazamiento grande con poca dispersión: donde la fórmula de
+    // la suma de cuadrados pierde todas las cifras
+    std::vector<double> data;
+    for (int i = 0; i < 1000; ++i) data.push_back(1e9 + std::sin(i * 0.7) + 0.001 * i);
+
+    double mean = 0.0;
+    for (double x : data) mean += x;
+    mean /= data.size();
+    double m2 = 0.0;
+    for (double x : data) m2 += (x - mean) * (x - mean);
+    double sd = std::sqrt(m2 / (data.size() - 1));
+
+    Welford all;
+    for (double x : data) all.add(x);
+    CHECK(all.n == (long long)data.size());
+    CHECK(near(all.mean, mean, 1e-15));
+    CHECK(near(all.sd(), sd, 1e-6));
+
+    // Trozos de tamaños distintos (vacíos y de uno incluidos), unidos en
+    // orden y al revés
+    const int cuts[] = {0, 0, 1, 7, 7, 300, 301, 999, 1000};
+    std::vector<Welford> parts;
+    for (int c = 0; c + 1 < (int)(sizeof(cuts) / sizeof(cuts[0])); ++c) {
+        Welford w;
+        for (int i = cuts[c]; i < cuts[c + 1]; ++i) w.add(data[i]);
+        parts.push_back(w);
+    }
+    Welford forward, backward;
+    for (const Welford& w : parts) forward.merge(w);
+    for (auto it = parts.rbegin(); it != parts.rend(); ++it) backward.merge(*it);
+    for (const Welford* w : {&forward, &backward}) {
+        CHECK(w->n == all.n);
+        CHECK(near(w->mean, mean, 1e-15));
+        CHECK(near(w->sd(), sd, 1e-6));
+    }
+
+    // Unir a uno vacío lo copia; unir uno vacío no cambia nada
+    Welford empty, copy;
+    copy.merge(all);
+    CHECK(copy.n == all.n && copy.mean == all.mean && copy.m2 == all.m2);
+    copy.merge(empty);
+    CHECK(copy.n == all.n && copy.mean == all.mean && copy.m2 == all.m2);
+
+    // Con menos de dos valores no hay desviación
+    Welford one;
+    CHECK(one.sd() == 0.0);
+    one.add(5.0);
+    CHECK(one.mean == 5.0 && one.sd() == 0.0);
+
+    return check_result();
+}
@@ -1,142 +1,29 @@
-extern "C" {
-#include "cec17.h"
-}
 #include <iostream>
-#include <vector>
-#include <random>
+#include "cec17.h"
+#include "engine.h"
+#include "multistart_soliswets.h"
 
 using namespace std;
 
-
-void clip(vector<double> &sol, int lower, int upper) {
-  for (auto &val : sol) {
-    if (val < lower) {
-      val = lower;
-    }
-    else if (val > upper) {
-      val = upper;
-    }
-  }
-}
-
-void increm_bias(vector<double> &bias, vector<double> dif) {
-  for (unsigned i = 0; i < bias.size(); i++) {
-    bias[i] = 0.2*bias[i]+0.4*(dif[i]+bias[i]);
-  }
-}
-
-void decrement_bias(vector<double> &bias, vector<double> dif) {
-  for (unsigned i = 0; i < bias.size(); i++) {
-    bias[i] = bias[i]-0.4*(dif[i]+bias[i]);
-  }
-}
-
-/**
- * Aplica el Solis Wets
- *
- * @param  sol solucion a mejorar.
- * @param fitness fitness de la solución.
- */
-template <class Random>
-void soliswets(vector<double> &sol, double &fitness, double delta, int maxevals, int lower, int upper, Random &random) {
-  const size_t dim = sol.size();
-  vector<double> bias (dim), dif (dim), newsol (dim);
-  double newfit;
-  size_t i;
-
-  int evals = 0;
-  int num_success = 0;
-  int num_failed = 0;
-
-  while (evals < maxevals) {
-    std::uniform_real_distribution<double> distribution(0.0, delta);
-
-    for (i = 0; i < dim; i++) {
-      dif[i] = distribution(random);
-      newsol[i] = sol[i] + dif[i] + bias[i];
-    }
-
-    clip(newsol, lower, upper);
-    newfit = cec17_fitness(&newsol[0]);
-    evals += 1;
-
-    if (newfit < fitness) {
-      sol = newsol;
-      fitness = newfit;
-      increm_bias(bias, dif);
-      num_success += 1;
-      num_failed = 0;
-    }
-    else if (evals < maxevals) {
-
-      for (i = 0; i < dim; i++) {
-        newsol[i] = sol[i] - dif[i] - bias[i];
-      }
-
-      clip(newsol, lower, upper);
-      newfit = cec17_fitness(&newsol[0]);
-      evals += 1;
-
-      if (newfit < fitness) {
-        sol = newsol;
-        fitness = newfit;
-        decrement_bias(bias, dif);
-        num_success += 1;
-        num_failed = 0;
-      }
-      else {
-        for (i = 0; i < dim; i++) {
-          bias[i] /= 2;
-        }
-
-        num_success = 0;
-        num_failed += 1;
-      }
-    }
-
-    if (num_success >= 5) {
-      num_success = 0;
-      delta *= 2;
-    }
-    else if (num_failed >= 3) {
-      num_failed = 0;
-      delta /= 2;
-    }
-  }
-
-}
-
 int main() {
-  vector<double> sol;
   int dim = 10;
   int seed = 42;
-  std::uniform_real_distribution<> dis(-100.0, 100.0);
-  
-  for (int funcid = 1; funcid <= 30; funcid++) {
-    vector<double> sol(dim);
-    vector<double> bestsol(dim);
-    const size_t maxtimes = 5;
-    double fitness, bestfitness = -1;
+  SolisWetsParams params;
+  params.delta = 0.2;
+  const int maxtimes = 5;
 
-    cec17_init("solis", funcid, dim);
-
-    cerr <<"Warning: output by console, if you want to create the output file you have to comment cec17_print_output()" <<endl;
-    cec17_print_output(); // Comment to generate the output file
-
-    std::mt19937 gen(seed); // Inicio semilla
+  for (int funcid = 1; funcid <= 30; funcid++) {
+    EngineConfig config{dim, funcid, "solis", 100000};
+    config.seed = seed;
+    config.verbose = false;
 
-    for (size_t times = 0; times < maxtimes; times++) {
-      for (int i = 0; i < dim; i++) {
-        sol[i] = dis(gen);
-      }
+    cerr <<"Warning: output by console, if you want to create the output file you have to set print_output to false" <<endl;
+    config.print_output = true; // false para generar el fichero de salida
 
-      fitness = cec17_fitness(&sol[0]);
-      soliswets(sol, fitness, 0.2, 100000/maxtimes-1, -100, 100, gen);
+    Engine engine(config);
+    MultiStartSolisWets solis(maxtimes, params);
+    double bestfitness = engine.run(solis);
 
-      if (bestfitness < 0 || fitness < bestfitness) {
-        bestfitness = fitness;
-      }
-    }
     cout <<"Best Random[F" <<funcid <<"]: " << scientific <<cec17_error(bestfitness) <<endl;
   }
 
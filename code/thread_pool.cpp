@@ -0,0 +1,70 @@
+// thread_pool.cpp
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(int num_threads, void (*on_exit)()) : on_exit_(on_exit) {
+    if (num_threads <= 0) {
+        num_threads = static_cast<int>(std::thread::hardware_concurrency());
+        if (num_threads <= 0) num_threads = 1;
+    }
+    workers_.reserve(num_threads - 1);
+    for (int t = 1; t < num_threads; ++t)
+        workers_.emplace_back([this, t] { worker_loop(t); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& w : workers_) w.join();
+}
+
+void ThreadPool::run(int n, bool fixed, Task task, void* ctx) {
+    if (n <= 0) return;
+    if (workers_.empty() || n == 1) {
+        for (int i = 0; i < n; ++i) task(ctx, i);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        task_ = task;
+        ctx_ = ctx;
+        n_ = n;
+        fixed_ = fixed;
+        next_.store(0, std::memory_order_relaxed);
+        busy_ = static_cast<int>(workers_.size());
+        ++epoch_;
+    }
+    start_cv_.notify_all();
+    work(0);
+    std::unique_lock<std::mutex> lock(mtx_);
+    done_cv_.wait(lock, [this] { return busy_ == 0; });
+}
+
+void ThreadPool::work(int id) {
+    if (fixed_) {
+        long long n = n_, t = size();
+        for (int i = (int)(id * n / t); i < (int)((id + 1) * n / t); ++i)
+            task_(ctx_, i);
+        return;
+    }
+    for (int i = next_.fetch_add(1); i < n_; i = next_.fetch_add(1))
+        task_(ctx_, i);
+}
+
+void ThreadPool::worker_loop(int id) {
+    unsigned long long seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            start_cv_.wait(lock, [&] { return stop_ || epoch_ != seen; });
+            if (stop_) break;
+            seen = epoch_;
+        }
+        work(id);
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (--busy_ == 0) done_cv_.notify_one();
+    }
+    if (on_exit_) on_exit_();
+}
@@ -0,0 +1,66 @@
+// thread_pool.h
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Pool de hilos fijo para bucles paralelos.
+// parallel_for no reserva memoria: el cuerpo se pasa por puntero y el hilo
+// que llama también trabaja, así que un pool de 1 hilo es secuencial.
+class ThreadPool {
+public:
+    // num_threads <= 0 -> todos los núcleos disponibles. Cada hilo del pool
+    // llama a on_exit (si hay) antes de terminar, para liberar su estado
+    // thread_local.
+    explicit ThreadPool(int num_threads = 0, void (*on_exit)() = nullptr);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return static_cast<int>(workers_.size()) + 1; }
+
+    // Ejecuta body(i) para i en [0, n) y espera a que terminen todos
+    template <class F>
+    void parallel_for(int n, F&& body) {
+        run(n, false, [](void* ctx, int i) { (*static_cast<std::remove_reference_t<F>*>(ctx))(i); }, &body);
+    }
+
+    // Igual, pero con reparto fijo: el hilo t (el que llama es el 0) siempre
+    // recibe el bloque contiguo t de [0, n). Sirve para que en llamadas
+    // sucesivas cada hilo trabaje con los mismos datos (siguen en su caché)
+    // o para ejecutar algo una vez en cada hilo.
+    template <class F>
+    void parallel_for_static(int n, F&& body) {
+        run(n, true, [](void* ctx, int i) { (*static_cast<std::remove_reference_t<F>*>(ctx))(i); }, &body);
+    }
+
+private:
+    using Task = void (*)(void*, int);
+
+    void run(int n, bool fixed, Task task, void* ctx);
+    void work(int id);
+    void worker_loop(int id);
+
+    std::vector<std::thread> workers_;
+    void (*on_exit_)() = nullptr;
+    std::mutex mtx_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    unsigned long long epoch_ = 0;
+    int busy_ = 0;
+    bool stop_ = false;
+
+    Task task_ = nullptr;
+    void* ctx_ = nullptr;
+    int n_ = 0;
+    bool fixed_ = false;
+    std::atomic<int> next_{0};
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,103 @@
+// trace.cpp
+#include "trace.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+
+static const std::uint32_t TRACE_MAGIC = 0x52544646;   // "FFTR"
+static const std::uint32_t TRACE_VERSION = 1;
+
+TraceSchedule::TraceSchedule(std::vector<long long> points) : points_(std::move(points)) {
+    std::sort(points_.begin(), points_.end());
+    points_.erase(std::unique(points_.begin(), points_.end()), points_.end());
+}
+
+TraceSchedule TraceSchedule::log_spaced(int points, long long max_fes) {
+    std::vector<long long> fes;
+    for (int i = 0; i < points; ++i) {
+        double t = points > 1 ? (double)i / (points - 1) : 1.0;
+        fes.push_back(std::max(1LL, std::llround(std::pow((double)max_fes, t))));
+    }
+    return TraceSchedule(std::move(fes));
+}
+
+TraceSchedule TraceSchedule::linear(int points, long long max_fes) {
+    std::vector<long long> fes;
+    for (int i = 1; i <= points; ++i) fes.push_back(std::max(1LL, max_fes * i / points));
+    return TraceSchedule(std::move(fes));
+}
+
+TraceSchedule TraceSchedule::custom(const std::vector<double>& fractions, long long max_fes) {
+    std::vector<long long> fes;
+    for (double f : fractions)
+        if (f > 0.0 && f <= 1.0) fes.push_back(std::max(1LL, std::llround(f * max_fes)));
+    return TraceSchedule(std::move(fes));
+}
+
+TraceRecorder::TraceRecorder(std::size_t capacity, const TraceSchedule& schedule)
+    : improvements_(std::max<std::size_t>(1, capacity)), schedule_(schedule.points()),
+      samples_(schedule_.size()) {
+    if (!schedule_.empty()) next_sample_ = schedule_[0];
+}
+
+void TraceRecorder::sample(long long fes, double best) {
+    // Una evaluación puede alcanzar varios puntos si están muy juntos
+    while (num_samples_ < schedule_.size() && schedule_[num_samples_] <= fes)
+        samples_[num_samples_++] = Point{fes, best};
+    next_sample_ = num_samples_ < schedule_.size() ? schedule_[num_samples_]
+                                                   : std::numeric_limits<long long>::max();
+}
+
+bool TraceRecorder::write(const std::string& path, int func_id, int dim, long long max_fes,
+                          unsigned long long seed) const {
+    FILE* out = std::fopen(path.c_str(), "wb");
+    if (out == nullptr) {
+        std::cerr << "Error: no se puede escribir " << path << "\n";
+        return false;
+    }
+    const double optimum = 100.0 * func_id;
+    long long kept = std::min<long long>(total_, (long long)improvements_.size());
+    long long dropped = total_ - kept;
+    long long samples = (long long)num_samples_;
+    std::fwrite(&TRACE_MAGIC, sizeof(TRACE_MAGIC), 1, out);
+    std::fwrite(&TRACE_VERSION, sizeof(TRACE_VERSION), 1, out);
+    std::fwrite(&func_id, sizeof(func_id), 1, out);
+    std::fwrite(&dim, sizeof(dim), 1, out);
+    std::fwrite(&max_fes, sizeof(max_fes), 1, out);
+    std::fwrite(&seed, sizeof(seed), 1, out);
+    std::fwrite(&optimum, sizeof(optimum), 1, out);
+    std::fwrite(&kept, sizeof(kept), 1, out);
+    std::fwrite(&dropped, sizeof(dropped), 1, out);
+    std::fwrite(&samples, sizeof(samples), 1, out);
+
+    // El anillo empieza en head_ cuando se ha llenado
+    auto put = [&](const Point& p) {
+        double error = p.fitness - optimum;
+        std::fwrite(&p.fes, sizeof(p.fes), 1, out);
+        std::fwrite(&error, sizeof(error), 1, out);
+    };
+    std::size_t first = dropped > 0 ? head_ : 0;
+    for (long long i = 0; i < kept; ++i) put(improvements_[(first + i) % improvements_.size()]);
+    for (long long i = 0; i < samples; ++i) put(samples_[i]);
+    return std::fclose(out) == 0;
+}
+
+void TraceRecorder::save(CheckpointWriter& out) const {
+    out.put((long long)head_);
+    out.put(total_);
+    out.put_array(improvements_.data(), improvements_.size());
+    out.put((long long)num_samples_);
+    out.put_array(samples_.data(), num_samples_);
+}
+
+void TraceRecorder::restore(CheckpointReader& in) {
+    head_ = (std::size_t)in.get<long long>() % improvements_.size();
+    total_ = in.get<long long>();
+    in.get_array(improvements_.data(), improvements_.size());
+    num_samples_ = std::min<std::size_t>((std::size_t)in.get<long long>(), schedule_.size());
+    in.get_array(samples_.data(), num_samples_);
+    next_sample_ = num_samples_ < schedule_.size() ? schedule_[num_samples_]
+                                                   : std::numeric_limits<long long>::max();
+}
@@ -0,0 +1,82 @@
+// trace.h
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+#include "checkpoint.h"
+
+// FEs en las que se anota el mejor, además de cada mejora. Sirve para
+// comparar el comportamiento anytime con más detalle que los 14 milestones.
+class TraceSchedule {
+public:
+    TraceSchedule() = default;
+
+    // points FEs repartidas en escala logarítmica / lineal en [1, max_fes]
+    static TraceSchedule log_spaced(int points, long long max_fes);
+    static TraceSchedule linear(int points, long long max_fes);
+    // Fracciones del presupuesto, en (0, 1]
+    static TraceSchedule custom(const std::vector<double>& fractions, long long max_fes);
+
+    const std::vector<long long>& points() const { return points_; }
+
+private:
+    explicit TraceSchedule(std::vector<long long> points);
+
+    std::vector<long long> points_;   // crecientes y sin repetir
+};
+
+// Traza de convergencia de una ejecución: (FE, fitness) en cada mejora del
+// mejor y en cada punto de la planificación. Todo se reserva al crearla;
+// anotar es copiar dos números, sin reservas ni formato. Si hay más mejoras
+// que capacidad se conservan las últimas (anillo) y se cuentan las perdidas.
+//
+// Fichero (binario, del mismo orden de bytes que la máquina):
+//   "FFTR", versión (u32), función, dimensión (i32), max_fes, semilla (i64),
+//   óptimo (f64), mejoras guardadas, mejoras perdidas, muestras (i64),
+//   mejoras y luego muestras como pares (FE i64, error f64) por FE creciente.
+class TraceRecorder {
+public:
+    TraceRecorder(std::size_t capacity, const TraceSchedule& schedule);
+
+    // Llamada en cada evaluación contabilizada
+    void record(long long fes, double fitness, double best, bool improved) {
+        if (improved) {
+            improvements_[head_] = Point{fes, fitness};
+            head_ = head_ + 1 == improvements_.size() ? 0 : head_ + 1;
+            ++total_;
+        }
+        if (fes >= next_sample_) sample(fes, best);
+    }
+
+    bool write(const std::string& path, int func_id, int dim, long long max_fes,
+               unsigned long long seed) const;
+
+    std::size_t capacity() const { return improvements_.size(); }
+    std::size_t schedule_size() const { return schedule_.size(); }
+
+    // Estado para los checkpoints; restore requiere la misma capacidad y
+    // planificación
+    void save(CheckpointWriter& out) const;
+    void restore(CheckpointReader& in);
+
+private:
+    struct Point {
+        long long fes;
+        double fitness;
+    };
+
+    void sample(long long fes, double best);
+
+    std::vector<Point> improvements_;   // anillo
+    std::size_t head_ = 0;              // siguiente hueco
+    long long total_ = 0;               // mejoras anotadas
+    std::vector<long long> schedule_;
+    std::vector<Point> samples_;        // una por punto alcanzado
+    std::size_t num_samples_ = 0;
+    long long next_sample_ = std::numeric_limits<long long>::max();
+};
+
+#endif // TRACE_H
@@ -0,0 +1,32 @@
+// welford.h
+#ifndef WELFORD_H
+#define WELFORD_H
+
+#include <cmath>
+
+// Media y varianza en una pasada; merge une dos acumuladores (Chan et al.)
+struct Welford {
+    long long n = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+
+    void add(double x) {
+        ++n;
+        double delta = x - mean;
+        mean += delta / n;
+        m2 += delta * (x - mean);
+    }
+
+    void merge(const Welford& o) {
+        if (o.n == 0) return;
+        long long total = n + o.n;
+        double delta = o.mean - mean;
+        mean += delta * o.n / total;
+        m2 += o.m2 + delta * delta * ((double)n * o.n / total);
+        n = total;
+    }
+
+    double sd() const { return n > 1 ? std::sqrt(m2 / (n - 1)) : 0.0; }
+};
+
+#endif // WELFORD_H